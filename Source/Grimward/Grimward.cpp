@@ -6,4 +6,5 @@
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Grimward, "Grimward" );
 
 DEFINE_LOG_CATEGORY(LogGrimward)
+DEFINE_LOG_CATEGORY(LogGrimwardHexMap)
  
\ No newline at end of file
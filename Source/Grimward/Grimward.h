@@ -4,5 +4,27 @@
 
 #include "CoreMinimal.h"
 
+/**
+ * Compile-time verbosity ceiling of the Grimward log categories. Shipping and Test builds
+ * strip everything below Warning, format arguments included. A single category can be
+ * overridden from Grimward.Build.cs, e.g. PublicDefinitions.Add("GW_LOG_MAX_VERBOSITY_LogGrimwardHexMap=Verbose").
+ */
+#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+#define GW_LOG_DEFAULT_MAX_VERBOSITY Warning
+#else
+#define GW_LOG_DEFAULT_MAX_VERBOSITY All
+#endif
+
+#ifndef GW_LOG_MAX_VERBOSITY_LogGrimward
+#define GW_LOG_MAX_VERBOSITY_LogGrimward GW_LOG_DEFAULT_MAX_VERBOSITY
+#endif
+
+#ifndef GW_LOG_MAX_VERBOSITY_LogGrimwardHexMap
+#define GW_LOG_MAX_VERBOSITY_LogGrimwardHexMap GW_LOG_DEFAULT_MAX_VERBOSITY
+#endif
+
 /** Main log category used across the project */
-DECLARE_LOG_CATEGORY_EXTERN(LogGrimward, Log, All);
+DECLARE_LOG_CATEGORY_EXTERN(LogGrimward, Log, GW_LOG_MAX_VERBOSITY_LogGrimward);
+
+/** Hex map widgets: per-frame summaries at Verbose, per-tile detail at VeryVerbose */
+DECLARE_LOG_CATEGORY_EXTERN(LogGrimwardHexMap, Log, GW_LOG_MAX_VERBOSITY_LogGrimwardHexMap);
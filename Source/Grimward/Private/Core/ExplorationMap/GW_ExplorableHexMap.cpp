@@ -2,10 +2,20 @@
 /*-------------------------------------------------------------------------*/
 #include "Core/ExplorationMap/GW_ExplorableHexMap.h"
 #include "Core/ExplorationMap/Widgets/GW_HexTile.h"
+#include "Core/ExplorationMap/Widgets/GW_HexMapCanvas.h"
+#include "Core/ExplorationMap/Widgets/GW_HexMinimapWidget.h"
 #include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "Core/ExplorationMap/GW_HexVisualsAsset.h"
+#include "Core/ExplorationMap/GW_HexMath.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Core/ExplorationMap/GW_HexPathfinder.h"
+#include "Core/ExplorationMap/GW_HexRevealService.h"
 #include "Components/CanvasPanel.h"
 #include "Components/CanvasPanelSlot.h"
+#include "Components/Image.h"
+#include "Components/InvalidationBox.h"
 #include "Blueprint/WidgetLayoutLibrary.h"
+#include "Misc/ScopeExit.h"
 #include "Grimward.h"
 /*-------------------------------------------------------------------------*/
 
@@ -21,19 +31,97 @@ void UGW_ExplorableHexMap::NativeConstruct()
     
     // Initialize state
     ViewportOffset = FVector2D::ZeroVector;
+    ViewVelocity = FVector2D::ZeroVector;
+    LastTickViewportOffset = FVector2D::ZeroVector;
+    LastTickDeltaTime = 0.0f;
     CurrentZoom = 1.0f;
+    LastTickZoom = CurrentZoom;
+    ViewAnchorWorld = FVector2D::ZeroVector;
+    ViewAnchorScreen = FVector2D::ZeroVector;
+    TargetZoom = CurrentZoom;
+    bVisibilityDirty = false;
+    TileBuildDeadline = 0.0;
+    LodBlend = 0.0f;
     bIsDragging = false;
     LastCenterGridPos = FIntPoint(0, 0);
     ActiveTile = nullptr;
+    ActiveGridPos = FIntPoint(INDEX_NONE, INDEX_NONE);
+    HoveredGridPos = FIntPoint(INDEX_NONE, INDEX_NONE);
+    PressedGridPos = FIntPoint(INDEX_NONE, INDEX_NONE);
     
-    UE_LOG(LogGrimward, Log, TEXT("GW_ExplorableHexMap constructed"));
+    // Tiles live in world-pixel space; pan/zoom is a single transform around the canvas origin
+    if (MapCanvas)
+    {
+        MapCanvas->SetRenderTransformPivot(FVector2D::ZeroVector);
+    }
+    
+    // Idle frames reuse the cached tile layer; anything that changes invalidates it itself
+    if (TileLayerCache)
+    {
+        TileLayerCache->SetCanCache(true);
+    }
+    
+    UE_LOG(LogGrimwardHexMap, Verbose, TEXT("GW_ExplorableHexMap constructed"));
+}
+
+void UGW_ExplorableHexMap::NativeDestruct()
+{
+    if (UGW_HexWorldState* WorldState = GetHexWorldState())
+    {
+        WorldState->OnExplorationChanged().Remove(ExplorationChangedHandle);
+    }
+    ExplorationChangedHandle.Reset();
+    
+    Super::NativeDestruct();
 }
 
 void UGW_ExplorableHexMap::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
     Super::NativeTick(MyGeometry, InDeltaTime);
     
-    // Could add smooth camera interpolation here if needed
+    // Every tile built this frame, by the visibility update or the queue, shares one budget
+    BeginTileBuildBudget(MapConfig.TileCreationBudgetMs);
+    
+    // Only the zoom eases; the offset follows from it so the anchored world point never drifts
+    if (CurrentZoom != TargetZoom)
+    {
+        CurrentZoom = MapConfig.CameraInterpSpeed > 0.0f && !FMath::IsNearlyEqual(CurrentZoom, TargetZoom, 0.0001f)
+            ? FMath::FInterpTo(CurrentZoom, TargetZoom, InDeltaTime, MapConfig.CameraInterpSpeed)
+            : TargetZoom;
+    }
+    
+    const FVector2D AnchoredOffset = GetAnchoredViewportOffset();
+    if (AnchoredOffset != ViewportOffset || CurrentZoom != LastTickZoom)
+    {
+        ViewportOffset = AnchoredOffset;
+        bVisibilityDirty = true;
+    }
+    LastTickZoom = CurrentZoom;
+    
+    // Track how fast the view moves so visibility can prefetch ahead of a pan
+    if (InDeltaTime > 0.0f)
+    {
+        ViewVelocity = (ViewportOffset - LastTickViewportOffset) / InDeltaTime;
+        LastTickDeltaTime = InDeltaTime;
+    }
+    LastTickViewportOffset = ViewportOffset;
+    
+    UpdateLodBlend(InDeltaTime);
+    AdvanceTransitions(InDeltaTime);
+    
+    // Every exploration change since the last frame goes up in one upload
+    LodTexture.Flush(GetHexWorldState());
+    
+    // At most one visibility update per frame, however many input events arrived
+    if (bVisibilityDirty)
+    {
+        UpdateVisibleTiles();
+    }
+    
+    // Whatever budget is left goes to tiles queued on earlier frames
+    ProcessPendingTiles();
+    
+    LogFrameSummary();
 }
 
 void UGW_ExplorableHexMap::InitializeMap(AGW_MapGenerator* InMapGenerator, int32 MapSeed, FIntPoint StartingGridPos)
@@ -44,6 +132,12 @@ void UGW_ExplorableHexMap::InitializeMap(AGW_MapGenerator* InMapGenerator, int32
         return;
     }
     
+    // Tiles from a previous map are stale
+    ResetVisibleTiles();
+    ClearTransitions();
+    KnownStateRect = FIntRect();
+    KnownStates.Reset();
+    
     MapGenerator = InMapGenerator;
     CurrentMapSeed = MapSeed;
     
@@ -53,13 +147,57 @@ void UGW_ExplorableHexMap::InitializeMap(AGW_MapGenerator* InMapGenerator, int32
         MapGenerator->GenerateBiomeMap(MapSeed);
     }
     
-    // Center on starting position
-    CenterOnGridPosition(StartingGridPos);
+    // Tile state lives in the world subsystem; it is kept if the store already holds this map.
+    // The canvases, pathfinder and reveal service all read the map from there.
+    UGW_HexWorldState* WorldState = GetHexWorldState();
+    if (WorldState)
+    {
+        if (WorldState->BindMap(MapGenerator))
+        {
+            PlacePOILoot(WorldState);
+        }
+        
+        if (!ExplorationChangedHandle.IsValid())
+        {
+            ExplorationChangedHandle = WorldState->OnExplorationChanged().AddUObject(this, &UGW_ExplorableHexMap::OnExplorationChanged);
+        }
+    }
     
-    // Populate initial tiles
-    UpdateVisibleTiles();
+    // The store can be the same object holding a newly bound map, which the layers' setters
+    // cannot see; repaint so the cached tile layer does not keep showing the previous map
+    for (UGW_HexMapCanvas* Layer : { HexCanvas, PlaceholderCanvas, FogCanvas })
+    {
+        if (Layer)
+        {
+            Layer->SetWorldState(WorldState);
+            Layer->RequestRepaint();
+        }
+    }
+    
+    SetupLodLayer();
+    
+    if (Minimap)
+    {
+        Minimap->SetHexMap(this);
+    }
+    
+    // Stream the atlases now; tiles built before they land are refreshed afterwards
+    if (HexVisuals)
+    {
+        HexVisuals->RequestAsyncLoad(FSimpleDelegate::CreateUObject(this, &UGW_ExplorableHexMap::OnHexVisualsLoaded));
+    }
     
-    UE_LOG(LogGrimward, Log, TEXT("Map initialized with seed %d at grid position (%d, %d)"),
+    // Widgets are created now rather than mid-pan; the batched canvas only needs a couple
+    const int32 PoolTarget = FMath::Min(HexCanvas ? 2 : CalculateMaxVisibleTileCount(), GetTilePoolCap());
+    TrimTilePool(PoolTarget);
+    PrewarmTilePool(PoolTarget);
+    
+    // Center on starting position and populate the first screen in full
+    CenterOnGridPosition(StartingGridPos);
+    BeginTileBuildBudget(-1.0f);
+    SnapViewToTarget();
+    
+    UE_LOG(LogGrimwardHexMap, Log, TEXT("Map initialized with seed %d at grid position (%d, %d)"),
         MapSeed, StartingGridPos.X, StartingGridPos.Y);
 }
 
@@ -70,35 +208,48 @@ void UGW_ExplorableHexMap::InitializeMapAtOrigin(AGW_MapGenerator* InMapGenerato
 
 UGW_HexTile* UGW_ExplorableHexMap::BuildHexTile(FIntPoint GridPos, int32 MapSeed)
 {
-    if (!MapGenerator)
+    const UGW_HexWorldState* WorldState = GetHexWorldState();
+    if (!WorldState)
     {
-        UE_LOG(LogGrimward, Error, TEXT("BuildHexTile: MapGenerator is null!"));
+        GW_LOG_RATE_LIMITED(LogGrimward, Error, 5.0f, TEXT("BuildHexTile: No HexWorldState!"));
         return nullptr;
     }
     
+    if (!WorldState->IsValidGridPosition(GridPos))
+    {
+        UE_LOG(LogGrimward, Error, TEXT("BuildHexTile: No tile data at (%d, %d)!"), GridPos.X, GridPos.Y);
+        return nullptr;
+    }
+    
+    return BuildHexTileFromData(WorldState->GetTileData(GridPos));
+}
+
+UGW_HexTile* UGW_ExplorableHexMap::BuildHexTileFromData(const FGW_HexTileData& TileData)
+{
     // Get tile from pool or create new
     UGW_HexTile* Tile = GetTileFromPool();
     if (!Tile)
     {
-        UE_LOG(LogGrimward, Error, TEXT("BuildHexTile: Failed to get tile from pool!"));
+        // Failed builds are retried every frame until a widget frees up
+        GW_LOG_RATE_LIMITED(LogGrimward, Error, 5.0f, TEXT("BuildHexTile: Failed to get tile from pool!"));
         return nullptr;
     }
     
-    // Get biome data from generator
-    FGW_BiomeData BiomeData = MapGenerator->GetBiomeDataAt(GridPos.X, GridPos.Y);
-    
-    // Build tile data
-    FGW_HexTileData TileData;
-    TileData.GridPosition = GridPos;
-    TileData.BiomeType = BiomeData.BiomeEntry;
-    TileData.POIType = EGW_HexPOI::None; // TODO: Implement POI generation
-    TileData.TileState = EGW_HexTileState::Hidden; // TODO: Get from player data
-    
     // Calculate pixel position
-    FVector2D PixelPos = GridToPixel(GridPos);
+    FVector2D PixelPos = GridToPixel(TileData.GridPosition);
     
     // Initialize the tile
+    Tile->SetVisuals(HexVisuals);
+    Tile->SetUseFogOverlay(FogCanvas == nullptr);
     Tile->InitializeTile(TileData, PixelPos);
+    Stats.TilesBuilt++;
+    
+    // Scrolled into view mid-transition: pick the animation up where the rest of the batch is
+    if (const int32* Index = TransitionIndices.Find(TileData.GridPosition))
+    {
+        const FGW_HexTileTransition& Transition = ActiveTransitions[*Index];
+        Tile->ApplyStateTransition(Transition.From, Transition.To, Transition.Alpha);
+    }
     
     return Tile;
 }
@@ -111,27 +262,27 @@ void UGW_ExplorableHexMap::AddTileToScreen(UGW_HexTile* Tile)
         return;
     }
     
-    // Add to canvas if not already added
-    if (!Tile->IsInViewport())
+    // Pooled tiles are already parented (IsInViewport only covers root widgets)
+    if (Tile->GetParent() != MapCanvas)
     {
-        UCanvasPanelSlot* CanvasSlot = MapCanvas->AddChildToCanvas(Tile);
-        
-        if (CanvasSlot)
-        {
-            // Set size
-            CanvasSlot->SetSize(FVector2D(MapConfig.HexWidth, MapConfig.HexHeight));
-            
-            // Set position accounting for viewport offset and zoom
-            FVector2D ScreenPos = GetScreenPosition(Tile->GetPixelPosition());
-            CanvasSlot->SetPosition(ScreenPos);
-            
-            // Set anchor to top-left
-            CanvasSlot->SetAnchors(FAnchors(0.0f, 0.0f, 0.0f, 0.0f));
-        }
+        AddTileToCanvas(Tile);
     }
     
+    // Placed in world-pixel space, MapCanvas' render transform handles pan/zoom
+    if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Tile->Slot))
+    {
+        CanvasSlot->SetPosition(Tile->GetPixelPosition());
+    }
+    Tile->SetVisibility(ESlateVisibility::HitTestInvisible);
+    
     // Track spawned tile
     SpawnedTiles.Add(Tile->GetGridPosition(), Tile);
+    
+    // The active hex was clicked, or scrolled away, before this tile existed
+    if (Tile->GetGridPosition() == ActiveGridPos && Tile != ActiveTile)
+    {
+        SetActiveTile(Tile);
+    }
 }
 
 void UGW_ExplorableHexMap::RemoveTileFromScreen(UGW_HexTile* Tile)
@@ -142,13 +293,13 @@ void UGW_ExplorableHexMap::RemoveTileFromScreen(UGW_HexTile* Tile)
     // Remove from tracking
     SpawnedTiles.Remove(Tile->GetGridPosition());
     
-    // Remove from canvas
-    if (Tile->IsInViewport())
+    // The hex stays active; whichever tile shows it next is selected in AddTileToScreen
+    if (Tile == ActiveTile)
     {
-        Tile->RemoveFromParent();
+        ActiveTile = nullptr;
     }
     
-    // Return to pool
+    // Return to pool; it leaves the canvas only if the pool is full
     ReturnTileToPool(Tile);
 }
 
@@ -157,61 +308,94 @@ void UGW_ExplorableHexMap::UpdateVisibleTiles()
     if (!MapGenerator || !MapCanvas)
         return;
     
-    // Calculate which tiles should be visible
-    TArray<FIntPoint> VisibleTilePositions = CalculateVisibleTileRange();
+    const double UpdateStartTime = FPlatformTime::Seconds();
+    ON_SCOPE_EXIT
+    {
+        Stats.VisibilityUpdates++;
+        Stats.VisibilityUpdateSeconds += FPlatformTime::Seconds() - UpdateStartTime;
+    };
+    
+    bVisibilityDirty = false;
+    ApplyViewTransform();
+    
+    const FIntRect VisibleRect = CalculateVisibleGridRect();
+    UpdateCanvasLayers(VisibleRect);
+    SyncKnownStates(VisibleRect);
     
-    // Track which tiles we need to keep
-    TSet<FIntPoint> NeededTiles;
-    for (const FIntPoint& Pos : VisibleTilePositions)
+    if (HexCanvas)
     {
-        NeededTiles.Add(Pos);
+        // The canvas paints every visible hex in one pass; only the selected and
+        // hovered hexes still get an interactive tile widget
+        UpdateInteractiveTiles(VisibleRect);
+        return;
     }
     
-    // Remove tiles that are no longer visible
-    TArray<FIntPoint> TilesToRemove;
-    for (const auto& Pair : SpawnedTiles)
+    // Fully faded to the LOD image: no tiles at all, so the frame cost no longer depends on the view
+    if (LodBlend >= 1.0f && WantsLod())
     {
-        if (!NeededTiles.Contains(Pair.Key))
-        {
-            TilesToRemove.Add(Pair.Key);
-        }
+        PendingTileCoords.Reset();
+        TileWindow.MoveTo(FIntRect(),
+            [this](const FIntPoint& Pos)
+            {
+                if (UGW_HexTile* Tile = SpawnedTiles.FindRef(Pos))
+                {
+                    RemoveTileFromScreen(Tile);
+                }
+            },
+            [](const FIntPoint&) {});
+        UpdatePlaceholders();
+        return;
     }
     
-    for (const FIntPoint& Pos : TilesToRemove)
+    const UGW_HexWorldState* WorldState = GetHexWorldState();
+    if (!WorldState)
     {
-        if (UGW_HexTile** TilePtr = SpawnedTiles.Find(Pos))
-        {
-            RemoveTileFromScreen(*TilePtr);
-        }
+        // Runs on every view update, so a missing subsystem must not flood the log
+        GW_LOG_RATE_LIMITED(LogGrimward, Error, 5.0f, TEXT("UpdateVisibleTiles: No HexWorldState!"));
+        return;
     }
     
-    // Add tiles that are newly visible
-    for (const FIntPoint& Pos : VisibleTilePositions)
-    {
-        if (!SpawnedTiles.Contains(Pos))
+    // Recycle the rows/columns that left the window and collect the ones that entered it
+    NewTileCoords.Reset();
+    PendingTileCoords.RemoveAll([&VisibleRect](const FIntPoint& Pos) { return !VisibleRect.Contains(Pos); });
+    TileWindow.MoveTo(VisibleRect,
+        [this](const FIntPoint& Pos)
         {
-            UGW_HexTile* NewTile = BuildHexTile(Pos, CurrentMapSeed);
-            if (NewTile)
+            if (UGW_HexTile* Tile = SpawnedTiles.FindRef(Pos))
             {
-                AddTileToScreen(NewTile);
+                RemoveTileFromScreen(Tile);
             }
+        },
+        [this](const FIntPoint& Pos)
+        {
+            NewTileCoords.Add(Pos);
+        });
+    
+    // Fetch all new tiles' data in one call, then build them
+    NewTileData.SetNumUninitialized(NewTileCoords.Num(), EAllowShrinking::No);
+    WorldState->GetTileDataForCoords(NewTileCoords, NewTileData);
+    
+    for (int32 i = 0; i < NewTileCoords.Num(); i++)
+    {
+        // Pool ran dry or the frame's build budget is spent: the queue takes the rest over later frames
+        if (TilePool.Num() == 0 || !HasTileBuildBudget())
+        {
+            PendingTileCoords.Append(&NewTileCoords[i], NewTileCoords.Num() - i);
+            break;
         }
-        else
+        
+        UGW_HexTile* NewTile = BuildHexTileFromData(NewTileData[i]);
+        if (!NewTile)
         {
-            // Update existing tile position for zoom/pan
-            if (UGW_HexTile** ExistingTile = SpawnedTiles.Find(Pos))
-            {
-                if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>((*ExistingTile)->Slot))
-                {
-                    FVector2D ScreenPos = GetScreenPosition((*ExistingTile)->GetPixelPosition());
-                    CanvasSlot->SetPosition(ScreenPos);
-                }
-            }
+            // The hex is in the window now, so it must stay queued or it is never retried
+            PendingTileCoords.Append(&NewTileCoords[i], NewTileCoords.Num() - i);
+            break;
         }
+        
+        AddTileToScreen(NewTile);
     }
     
-    UE_LOG(LogGrimward, Log, TEXT("UpdateVisibleTiles: %d tiles visible, %d tiles spawned"),
-        VisibleTilePositions.Num(), SpawnedTiles.Num());
+    UpdatePlaceholders();
 }
 
 // ========================================
@@ -220,27 +404,31 @@ void UGW_ExplorableHexMap::UpdateVisibleTiles()
 
 FVector2D UGW_ExplorableHexMap::GridToPixel(FIntPoint GridPos) const
 {
-    // Axial to pixel conversion for flat-topped hexagons
-    // Using offset coordinates (odd-r)
-    const float HexWidth = MapConfig.HexWidth;
-    const float HexHeight = MapConfig.HexHeight;
-    
-    float X = GridPos.X * HexWidth * 0.75f;
-    float Y = GridPos.Y * HexHeight + (GridPos.X % 2) * (HexHeight * 0.5f);
-    
-    return FVector2D(X, Y);
+    return GW_HexMath::GridToPixel(GridPos, FVector2D(MapConfig.HexWidth, MapConfig.HexHeight));
 }
 
 FIntPoint UGW_ExplorableHexMap::PixelToGrid(FVector2D PixelPos) const
 {
-    // Reverse conversion (approximate - for click detection you'd want more precision)
-    const float HexWidth = MapConfig.HexWidth;
-    const float HexHeight = MapConfig.HexHeight;
-    
-    int32 X = FMath::RoundToInt(PixelPos.X / (HexWidth * 0.75f));
-    int32 Y = FMath::RoundToInt((PixelPos.Y - (X % 2) * (HexHeight * 0.5f)) / HexHeight);
+    // Exact inverse of GridToPixel: returns the hex whose outline contains the point
+    return GW_HexMath::PixelToGrid(PixelPos, FVector2D(MapConfig.HexWidth, MapConfig.HexHeight));
+}
+
+FIntPoint UGW_ExplorableHexMap::ScreenToGrid(const FGeometry& InGeometry, FVector2D ScreenSpacePos) const
+{
+    const FVector2D LocalPos = InGeometry.AbsoluteToLocal(ScreenSpacePos);
+    return PixelToGrid(LocalPos / CurrentZoom - ViewportOffset);
+}
+
+FBox2D UGW_ExplorableHexMap::GetViewGridBounds() const
+{
+    if (!MapGenerator || CurrentZoom <= 0.0f)
+        return FBox2D(ForceInit);
     
-    return FIntPoint(X, Y);
+    // Visible world pixels (inverse of GetScreenPosition), scaled by the column and row spacing
+    const FVector2D ViewMin = -ViewportOffset;
+    const FVector2D ViewMax = ViewMin + GetViewportSize() / CurrentZoom;
+    const FVector2D GridSpacing(MapConfig.HexWidth * 0.75, MapConfig.HexHeight);
+    return FBox2D(ViewMin / GridSpacing, ViewMax / GridSpacing);
 }
 
 FVector2D UGW_ExplorableHexMap::GetScreenPosition(FVector2D WorldPixelPos) const
@@ -248,33 +436,71 @@ FVector2D UGW_ExplorableHexMap::GetScreenPosition(FVector2D WorldPixelPos) const
     return (WorldPixelPos + ViewportOffset) * CurrentZoom;
 }
 
+void UGW_ExplorableHexMap::ApplyViewTransform()
+{
+    if (!MapCanvas)
+        return;
+    
+    // Same mapping as GetScreenPosition: scale about the origin, then translate
+    FWidgetTransform ViewTransform;
+    ViewTransform.Translation = ViewportOffset * CurrentZoom;
+    ViewTransform.Scale = FVector2D(CurrentZoom, CurrentZoom);
+    
+    // Setting it invalidates the cached tile layer, so only do so when the view really moved
+    if (MapCanvas->GetRenderTransform() == ViewTransform)
+        return;
+    
+    MapCanvas->SetRenderTransform(ViewTransform);
+}
+
 // ========================================
 // Camera Control
 // ========================================
 
 void UGW_ExplorableHexMap::PanViewport(FVector2D Delta)
 {
-    ViewportOffset += Delta;
-    UpdateVisibleTiles();
+    // The offset is applied before zoom, so a screen delta is converted at the zoom on screen
+    ViewAnchorWorld -= Delta / CurrentZoom;
 }
 
 void UGW_ExplorableHexMap::SetZoom(float NewZoom)
 {
-    CurrentZoom = FMath::Clamp(NewZoom, MapConfig.ZoomRange.X, MapConfig.ZoomRange.Y);
+    const float ClampedZoom = FMath::Clamp(NewZoom, MapConfig.ZoomRange.X, MapConfig.ZoomRange.Y);
+    
+    // Anchor the world point at the viewport centre; it stays there for the whole ease
+    const FVector2D ViewportCenter = GetViewportSize() * 0.5f;
+    ViewAnchorWorld += (ViewportCenter - ViewAnchorScreen) / CurrentZoom;
+    ViewAnchorScreen = ViewportCenter;
+    
+    TargetZoom = ClampedZoom;
+}
+
+FVector2D UGW_ExplorableHexMap::GetAnchoredViewportOffset() const
+{
+    // Solve GetScreenPosition(ViewAnchorWorld) == ViewAnchorScreen at the current zoom
+    return ViewAnchorScreen / CurrentZoom - ViewAnchorWorld;
+}
+
+void UGW_ExplorableHexMap::SnapViewToTarget()
+{
+    CurrentZoom = TargetZoom;
+    LastTickZoom = CurrentZoom;
+    ViewportOffset = GetAnchoredViewportOffset();
+    LastTickViewportOffset = ViewportOffset;
+    ViewVelocity = FVector2D::ZeroVector;
+    
     UpdateVisibleTiles();
 }
 
 void UGW_ExplorableHexMap::CenterOnGridPosition(FIntPoint GridPos)
 {
-    FVector2D PixelPos = GridToPixel(GridPos);
-    
-    // TODO: Get actual viewport size instead of hardcoded value
-    FVector2D ViewportCenter = FVector2D(960.0f, 540.0f); // 1920x1080 / 2
+    const FVector2D HexCentre = GridToPixel(GridPos) + FVector2D(MapConfig.HexWidth, MapConfig.HexHeight) * 0.5f;
+    const FVector2D ViewportCenter = GetViewportSize() * 0.5f;
     
-    ViewportOffset = ViewportCenter - PixelPos * CurrentZoom;
+    // Zooming keeps the hex centred from here on
+    ViewAnchorWorld = HexCentre;
+    ViewAnchorScreen = ViewportCenter;
     LastCenterGridPos = GridPos;
-    
-    UpdateVisibleTiles();
 }
 
 // ========================================
@@ -290,6 +516,14 @@ FReply UGW_ExplorableHexMap::NativeOnMouseButtonDown(const FGeometry& InGeometry
         return FReply::Handled().CaptureMouse(TakeWidget());
     }
     
+    // Tiles are hit-test invisible; the hex under the cursor is computed instead
+    if (InMouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
+    {
+        // Captured so the release reaches the map even if the cursor left it in between
+        PressedGridPos = ScreenToGrid(InGeometry, InMouseEvent.GetScreenSpacePosition());
+        return FReply::Handled().CaptureMouse(TakeWidget());
+    }
+    
     return Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
 }
 
@@ -298,7 +532,22 @@ FReply UGW_ExplorableHexMap::NativeOnMouseButtonUp(const FGeometry& InGeometry,
     if (InMouseEvent.GetEffectingButton() == EKeys::RightMouseButton)
     {
         bIsDragging = false;
-        return FReply::Handled().ReleaseMouseCapture();
+        
+        // A left press still held keeps the capture until its own release
+        return PressedGridPos == FIntPoint(INDEX_NONE, INDEX_NONE) ? FReply::Handled().ReleaseMouseCapture() : FReply::Handled();
+    }
+    
+    // Like a button, a click needs press and release on the same hex
+    if (InMouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
+    {
+        const FIntPoint GridPos = ScreenToGrid(InGeometry, InMouseEvent.GetScreenSpacePosition());
+        if (GridPos == PressedGridPos)
+        {
+            ClickGridPosition(GridPos);
+        }
+        
+        PressedGridPos = FIntPoint(INDEX_NONE, INDEX_NONE);
+        return bIsDragging ? FReply::Handled() : FReply::Handled().ReleaseMouseCapture();
     }
     
     return Super::NativeOnMouseButtonUp(InGeometry, InMouseEvent);
@@ -311,21 +560,31 @@ FReply UGW_ExplorableHexMap::NativeOnMouseMove(const FGeometry& InGeometry, cons
         FVector2D CurrentPosition = InMouseEvent.GetScreenSpacePosition();
         FVector2D Delta = CurrentPosition - LastDragPosition;
         
-        PanViewport(Delta);
+        // Screen space includes the DPI scale, the view works in local units
+        PanViewport(Delta / InGeometry.Scale);
         
         LastDragPosition = CurrentPosition;
         return FReply::Handled();
     }
     
+    SetHoveredGridPosition(ScreenToGrid(InGeometry, InMouseEvent.GetScreenSpacePosition()));
+    
     return Super::NativeOnMouseMove(InGeometry, InMouseEvent);
 }
 
+void UGW_ExplorableHexMap::NativeOnMouseLeave(const FPointerEvent& InMouseEvent)
+{
+    SetHoveredGridPosition(FIntPoint(INDEX_NONE, INDEX_NONE));
+    
+    Super::NativeOnMouseLeave(InMouseEvent);
+}
+
 FReply UGW_ExplorableHexMap::NativeOnMouseWheel(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
 {
     float WheelDelta = InMouseEvent.GetWheelDelta();
     float ZoomDelta = WheelDelta * 0.1f;
     
-    SetZoom(CurrentZoom + ZoomDelta);
+    SetZoom(TargetZoom + ZoomDelta);
     
     return FReply::Handled();
 }
@@ -334,6 +593,52 @@ FReply UGW_ExplorableHexMap::NativeOnMouseWheel(const FGeometry& InGeometry, con
 // Tile Selection
 // ========================================
 
+void UGW_ExplorableHexMap::ClickGridPosition(FIntPoint GridPos)
+{
+    if (!MapGenerator || !MapGenerator->IsValidGridPosition(GridPos))
+        return;
+    
+    // Deselect the previous tile; the hex stays active while its tile is still queued, and
+    // AddTileToScreen selects the tile once it is built
+    SetActiveTile(SpawnedTiles.FindRef(GridPos));
+    ActiveGridPos = GridPos;
+    
+    // With the batched canvas the tile widget only exists once the hex is active
+    if (HexCanvas)
+    {
+        UpdateInteractiveTiles(CalculateVisibleGridRect());
+    }
+    
+    if (ActiveTile)
+    {
+        ActiveTile->OnTileClicked();
+    }
+}
+
+void UGW_ExplorableHexMap::SetHoveredGridPosition(FIntPoint GridPos)
+{
+    if (GridPos == HoveredGridPos)
+        return;
+    
+    if (UGW_HexTile* OldTile = SpawnedTiles.FindRef(HoveredGridPos))
+    {
+        OldTile->OnTileUnhovered();
+    }
+    
+    HoveredGridPos = GridPos;
+    
+    // With the batched canvas, the hovered hex is the only one besides the selection with a widget
+    if (HexCanvas)
+    {
+        UpdateInteractiveTiles(CalculateVisibleGridRect());
+    }
+    
+    if (UGW_HexTile* NewTile = SpawnedTiles.FindRef(HoveredGridPos))
+    {
+        NewTile->OnTileHovered();
+    }
+}
+
 void UGW_ExplorableHexMap::SetActiveTile(UGW_HexTile* Tile)
 {
     // Deselect previous active tile
@@ -343,11 +648,12 @@ void UGW_ExplorableHexMap::SetActiveTile(UGW_HexTile* Tile)
     }
     
     ActiveTile = Tile;
+    ActiveGridPos = Tile ? Tile->GetGridPosition() : FIntPoint(INDEX_NONE, INDEX_NONE);
     
     if (ActiveTile)
     {
         ActiveTile->SetSelected(true);
-        UE_LOG(LogGrimward, Log, TEXT("Active tile set to grid position (%d, %d)"),
+        UE_LOG(LogGrimwardHexMap, Verbose, TEXT("Active tile set to grid position (%d, %d)"),
             ActiveTile->GetGridPosition().X, ActiveTile->GetGridPosition().Y);
     }
 }
@@ -356,92 +662,622 @@ void UGW_ExplorableHexMap::SetActiveTile(UGW_HexTile* Tile)
 // Utility
 // ========================================
 
+UGW_HexWorldState* UGW_ExplorableHexMap::GetHexWorldState() const
+{
+    UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<UGW_HexWorldState>() : nullptr;
+}
+
+UGW_HexPathfinder* UGW_ExplorableHexMap::GetHexPathfinder() const
+{
+    UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<UGW_HexPathfinder>() : nullptr;
+}
+
+UGW_HexRevealService* UGW_ExplorableHexMap::GetHexRevealService() const
+{
+    UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<UGW_HexRevealService>() : nullptr;
+}
+
+void UGW_ExplorableHexMap::RevealAround(FIntPoint GridPos)
+{
+    // The store broadcasts once; OnExplorationChanged repaints fog and refreshes tiles
+    if (UGW_HexRevealService* RevealService = GetHexRevealService())
+    {
+        RevealService->RevealFrom(GridPos, MapConfig.SightRadius);
+    }
+}
+
 TArray<FIntPoint> UGW_ExplorableHexMap::GetHexNeighbors(FIntPoint GridPos) const
 {
+    // Blueprint needs an array; native code should use GW_HexMath::Neighbor directly
     TArray<FIntPoint> Neighbors;
+    Neighbors.Reserve(6);
+    for (int32 Dir = 0; Dir < 6; Dir++)
+    {
+        Neighbors.Add(GW_HexMath::Neighbor(GridPos, Dir));
+    }
+    return Neighbors;
+}
+
+int32 UGW_ExplorableHexMap::GetHexDistance(FIntPoint A, FIntPoint B) const
+{
+    return GW_HexMath::Distance(A, B);
+}
+
+// ========================================
+// Internal Helpers
+// ========================================
+
+void UGW_ExplorableHexMap::OnHexVisualsLoaded()
+{
+    for (const auto& Pair : SpawnedTiles)
+    {
+        Pair.Value->RefreshVisuals();
+    }
+}
+
+void UGW_ExplorableHexMap::OnExplorationChanged(const FIntRect& DirtyRect)
+{
+    if (FogCanvas)
+    {
+        FogCanvas->RequestRepaint();
+    }
     
-    // Axial coordinate neighbors for flat-topped hexagons
-    static const TArray<FIntPoint> EvenRowOffsets = {
-        FIntPoint(1, 0), FIntPoint(0, -1), FIntPoint(-1, -1),
-        FIntPoint(-1, 0), FIntPoint(-1, 1), FIntPoint(0, 1)
-    };
+    const UGW_HexWorldState* WorldState = GetHexWorldState();
+    if (!WorldState)
+        return;
     
-    static const TArray<FIntPoint> OddRowOffsets = {
-        FIntPoint(1, 0), FIntPoint(1, -1), FIntPoint(0, -1),
-        FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(1, 1)
-    };
+    // A resized store is a different map; rebuild rather than patch
+    if (LodTexture.Texture)
+    {
+        if (WorldState->GetMapSize() != LodTexture.Size)
+        {
+            SetupLodLayer();
+        }
+        else
+        {
+            LodTexture.AddPendingRegion(DirtyRect);
+        }
+    }
+    
+    // Only widgets that exist need a fresh snapshot; everything else reads the store when built
+    for (const auto& Pair : SpawnedTiles)
+    {
+        if (DirtyRect.Contains(Pair.Key))
+        {
+            Pair.Value->ApplyTileData(WorldState->GetTileData(Pair.Key));
+        }
+    }
+    
+    // Only the visible part of the change animates; one bulk read, then a diff against what was shown
+    FIntRect Overlap = KnownStateRect;
+    Overlap.Clip(DirtyRect);
+    if (Overlap.Width() <= 0 || Overlap.Height() <= 0)
+        return;
+    
+    ChangedStates.SetNumUninitialized(Overlap.Area(), EAllowShrinking::No);
+    WorldState->GetTileStatesInRect(Overlap, ChangedStates);
+    
+    int32 StateIndex = 0;
+    for (int32 Y = Overlap.Min.Y; Y < Overlap.Max.Y; Y++)
+    {
+        for (int32 X = Overlap.Min.X; X < Overlap.Max.X; X++, StateIndex++)
+        {
+            EGW_HexTileState& Known = KnownStates[(Y - KnownStateRect.Min.Y) * KnownStateRect.Width() + (X - KnownStateRect.Min.X)];
+            const EGW_HexTileState Current = ChangedStates[StateIndex];
+            if (Known != Current)
+            {
+                StartTransition(FIntPoint(X, Y), Known, Current);
+                Known = Current;
+            }
+        }
+    }
     
-    const TArray<FIntPoint>& Offsets = (GridPos.X % 2 == 0) ? EvenRowOffsets : OddRowOffsets;
+    // The repaint requested above must already show the transitions at their start
+    if (FogCanvas && ActiveTransitions.Num() > 0)
+    {
+        FogCanvas->SetStateTransitions(ActiveTransitions);
+    }
+}
+
+void UGW_ExplorableHexMap::PlacePOILoot(UGW_HexWorldState* WorldState)
+{
+    if (POILoot.Num() == 0 || !MapGenerator)
+        return;
     
-    for (const FIntPoint& Offset : Offsets)
+    // The generator only says where POIs were placed; what stands there now is the world state's
+    int32 Placed = 0;
+    for (const FIntPoint& GridPos : MapGenerator->GetPOILocations())
     {
-        Neighbors.Add(GridPos + Offset);
+        const FGW_HexLootList* LootList = POILoot.Find(WorldState->GetPOI(GridPos));
+        if (LootList && LootList->Items.Num() > 0)
+        {
+            WorldState->SetTileLoot(GridPos, LootList->Items);
+            Placed++;
+        }
     }
     
-    return Neighbors;
+    UE_LOG(LogGrimwardHexMap, Log, TEXT("Placed loot on %d POIs"), Placed);
 }
 
-int32 UGW_ExplorableHexMap::GetHexDistance(FIntPoint A, FIntPoint B) const
+void UGW_ExplorableHexMap::SyncKnownStates(const FIntRect& VisibleRect)
 {
-    // Simplified distance calculation for offset coordinates
-    int32 DX = FMath::Abs(A.X - B.X);
-    int32 DY = FMath::Abs(A.Y - B.Y);
+    const UGW_HexWorldState* WorldState = GetHexWorldState();
+    const FIntRect Rect = WorldState ? WorldState->ClipRectToMap(VisibleRect) : FIntRect();
+    if (Rect == KnownStateRect)
+        return;
     
-    return DX + FMath::Max(0, (DY - DX) / 2);
+    KnownStateRect = Rect;
+    KnownStates.SetNumUninitialized(Rect.Area(), EAllowShrinking::No);
+    if (KnownStates.Num() > 0)
+    {
+        WorldState->GetTileStatesInRect(Rect, KnownStates);
+    }
 }
 
-// ========================================
-// Internal Helpers
-// ========================================
+void UGW_ExplorableHexMap::StartTransition(FIntPoint GridPos, EGW_HexTileState From, EGW_HexTileState To)
+{
+    // Instant: tiles already show the new state and the fog layer reads it from the store
+    if (MapConfig.StateTransitionTime <= 0.0f)
+        return;
+    
+    FGW_HexTileTransition Transition;
+    Transition.GridPosition = GridPos;
+    Transition.From = From;
+    Transition.To = To;
+    Transition.Elapsed = 0.0f;
+    Transition.Alpha = 0.0f;
+    
+    if (const int32* Index = TransitionIndices.Find(GridPos))
+    {
+        ActiveTransitions[*Index] = Transition;
+    }
+    else
+    {
+        TransitionIndices.Add(GridPos, ActiveTransitions.Add(Transition));
+    }
+    
+    if (UGW_HexTile* Tile = SpawnedTiles.FindRef(GridPos))
+    {
+        Tile->ApplyStateTransition(From, To, 0.0f);
+    }
+}
+
+void UGW_ExplorableHexMap::AdvanceTransitions(float DeltaTime)
+{
+    if (ActiveTransitions.Num() == 0)
+        return;
+    
+    // Frame time rather than wall time, so paused or time-dilated frames hold the animation too
+    const float Duration = FMath::Max(MapConfig.StateTransitionTime, UE_KINDA_SMALL_NUMBER);
+    
+    for (int32 i = ActiveTransitions.Num() - 1; i >= 0; i--)
+    {
+        FGW_HexTileTransition& Transition = ActiveTransitions[i];
+        Transition.Elapsed += DeltaTime;
+        Transition.Alpha = FMath::Clamp(Transition.Elapsed / Duration, 0.0f, 1.0f);
+        
+        if (UGW_HexTile* Tile = SpawnedTiles.FindRef(Transition.GridPosition))
+        {
+            Tile->ApplyStateTransition(Transition.From, Transition.To, Transition.Alpha);
+        }
+        
+        if (Transition.Alpha >= 1.0f)
+        {
+            // The last entry moves into this slot; it was already advanced this frame
+            TransitionIndices.Remove(Transition.GridPosition);
+            ActiveTransitions.RemoveAtSwap(i, EAllowShrinking::No);
+            if (i < ActiveTransitions.Num())
+            {
+                TransitionIndices.Add(ActiveTransitions[i].GridPosition, i);
+            }
+        }
+    }
+    
+    // Once empty this sends the final, empty list so the fog layer paints the stored states again
+    if (FogCanvas)
+    {
+        FogCanvas->SetStateTransitions(ActiveTransitions);
+    }
+}
+
+void UGW_ExplorableHexMap::ClearTransitions()
+{
+    for (const FGW_HexTileTransition& Transition : ActiveTransitions)
+    {
+        if (UGW_HexTile* Tile = SpawnedTiles.FindRef(Transition.GridPosition))
+        {
+            Tile->ApplyStateTransition(Transition.To, Transition.To, 1.0f);
+        }
+    }
+    
+    ActiveTransitions.Reset();
+    TransitionIndices.Reset();
+    
+    if (FogCanvas)
+    {
+        FogCanvas->SetStateTransitions(ActiveTransitions);
+    }
+}
+
+void UGW_ExplorableHexMap::SetupLodLayer()
+{
+    if (!LodImage || !MapGenerator)
+        return;
+    
+    // The image sits above the tiles and the fog layer, so it must mask hexes the same way they do
+    const FLinearColor HiddenTint = FogCanvas ? FogCanvas->HiddenFogColor : FLinearColor::Black;
+    const FLinearColor ExploredTint = FogCanvas ? FogCanvas->ExploredFogColor : FLinearColor(0.0f, 0.0f, 0.0f, 0.3f);
+    LodTexture.SetTints(HiddenTint, ExploredTint, FLinearColor::Transparent);
+    
+    // One texel per hex; nearest filtering keeps hex colours crisp when magnified
+    LodTexture.Rebuild(GetHexWorldState(), TF_Nearest);
+    LodImage->SetBrushFromTexture(LodTexture.Texture);
+    
+    const float HexWidth = MapConfig.HexWidth;
+    const float HexHeight = MapConfig.HexHeight;
+    
+    // Texel X is centred on its column; rows split the half-row parity shift (+/- a quarter hex)
+    if (UCanvasPanelSlot* ImageSlot = Cast<UCanvasPanelSlot>(LodImage->Slot))
+    {
+        ImageSlot->SetAnchors(FAnchors(0.0f, 0.0f, 0.0f, 0.0f));
+        ImageSlot->SetPosition(FVector2D(HexWidth * 0.125f, HexHeight * 0.25f));
+        ImageSlot->SetSize(FVector2D(MapGenerator->GenWidth * HexWidth * 0.75f, MapGenerator->GenHeight * HexHeight));
+        ImageSlot->SetZOrder(1000);
+    }
+    
+    // The grid outline repeats every two columns horizontally and every row vertically
+    if (LodGridOverlay)
+    {
+        FSlateBrush GridBrush = LodGridOverlay->GetBrush();
+        GridBrush.ImageSize = FVector2D(HexWidth * 1.5f, HexHeight);
+        GridBrush.Tiling = ESlateBrushTileType::Both;
+        LodGridOverlay->SetBrush(GridBrush);
+        
+        if (UCanvasPanelSlot* GridSlot = Cast<UCanvasPanelSlot>(LodGridOverlay->Slot))
+        {
+            GridSlot->SetAnchors(FAnchors(0.0f, 0.0f, 0.0f, 0.0f));
+            GridSlot->SetPosition(FVector2D::ZeroVector);
+            GridSlot->SetSize(FVector2D(MapGenerator->GenWidth * HexWidth * 0.75f + HexWidth * 0.25f,
+                MapGenerator->GenHeight * HexHeight + HexHeight * 0.5f));
+            GridSlot->SetZOrder(1001);
+        }
+    }
+    
+    // Snap to the right state for the current zoom
+    LodBlend = WantsLod() ? 1.0f : 0.0f;
+    UpdateLodBlend(0.0f);
+}
+
+bool UGW_ExplorableHexMap::WantsLod() const
+{
+    return LodImage && LodTexture.Texture && CurrentZoom < MapConfig.LodZoomThreshold;
+}
+
+void UGW_ExplorableHexMap::UpdateLodBlend(float DeltaTime)
+{
+    if (!LodImage)
+        return;
+    
+    const float Target = WantsLod() ? 1.0f : 0.0f;
+    const float PreviousBlend = LodBlend;
+    
+    LodBlend = MapConfig.LodFadeTime > 0.0f
+        ? FMath::FInterpConstantTo(LodBlend, Target, DeltaTime, 1.0f / MapConfig.LodFadeTime)
+        : Target;
+    
+    // Nothing to re-apply while settled (DeltaTime 0 forces a sync)
+    if (LodBlend == PreviousBlend && DeltaTime > 0.0f)
+        return;
+    
+    const ESlateVisibility LodVisibility = LodBlend > 0.0f ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed;
+    for (UImage* Layer : { LodImage, LodGridOverlay })
+    {
+        if (Layer)
+        {
+            Layer->SetRenderOpacity(LodBlend);
+            Layer->SetVisibility(LodVisibility);
+        }
+    }
+    
+    // The batched canvas is fully covered once faded in, so stop painting it
+    if (HexCanvas)
+    {
+        HexCanvas->SetVisibility(LodBlend >= 1.0f ? ESlateVisibility::Collapsed : ESlateVisibility::HitTestInvisible);
+    }
+    
+    // Just finished fading in: park the tiles
+    if (LodBlend >= 1.0f && PreviousBlend < 1.0f)
+    {
+        bVisibilityDirty = true;
+    }
+}
+
+void UGW_ExplorableHexMap::UpdateCanvasLayers(const FIntRect& VisibleRect)
+{
+    const FVector2D HexSize(MapConfig.HexWidth, MapConfig.HexHeight);
+    
+    for (UGW_HexMapCanvas* Layer : { HexCanvas, FogCanvas })
+    {
+        if (Layer)
+        {
+            Layer->SetView(ViewportOffset, CurrentZoom, HexSize);
+            Layer->SetVisibleRect(VisibleRect);
+        }
+    }
+}
 
 UGW_HexTile* UGW_ExplorableHexMap::GetTileFromPool()
 {
     // Try to get from pool first
     if (TilePool.Num() > 0)
     {
+        Stats.PoolHits++;
         return TilePool.Pop();
     }
     
     // Create new tile if pool is empty
-    if (HexTileClass)
+    if (!HexTileClass)
     {
-        return CreateWidget<UGW_HexTile>(GetOwningPlayer(), HexTileClass);
+        UE_LOG(LogGrimward, Error, TEXT("GetTileFromPool: HexTileClass not set!"));
+        return nullptr;
     }
     
-    UE_LOG(LogGrimward, Error, TEXT("GetTileFromPool: HexTileClass not set!"));
-    return nullptr;
+    const int32 PoolCap = GetTilePoolCap();
+    if (SpawnedTiles.Num() >= PoolCap)
+    {
+        GW_LOG_RATE_LIMITED(LogGrimward, Warning, 5.0f, TEXT("GetTileFromPool: Tile cap (%d) reached"), PoolCap);
+        return nullptr;
+    }
+    
+    Stats.PoolMisses++;
+    return CreateWidget<UGW_HexTile>(GetOwningPlayer(), HexTileClass);
 }
 
 void UGW_ExplorableHexMap::ReturnTileToPool(UGW_HexTile* Tile)
 {
-    if (Tile)
+    if (!Tile)
+        return;
+    
+    if (TilePool.Num() + SpawnedTiles.Num() < GetTilePoolCap())
     {
+        // Kept parented and collapsed, so reusing it does not rebuild its Slate tree or rerun NativeConstruct
+        Tile->SetSelected(false);
+        Tile->SetVisibility(ESlateVisibility::Collapsed);
         TilePool.Add(Tile);
     }
+    else
+    {
+        Tile->RemoveFromParent();
+    }
 }
 
-TArray<FIntPoint> UGW_ExplorableHexMap::CalculateVisibleTileRange() const
+void UGW_ExplorableHexMap::AddTileToCanvas(UGW_HexTile* Tile)
 {
-    TArray<FIntPoint> VisibleTiles;
+    if (UCanvasPanelSlot* CanvasSlot = MapCanvas->AddChildToCanvas(Tile))
+    {
+        CanvasSlot->SetSize(FVector2D(MapConfig.HexWidth, MapConfig.HexHeight));
+        CanvasSlot->SetAnchors(FAnchors(0.0f, 0.0f, 0.0f, 0.0f));
+    }
+}
+
+void UGW_ExplorableHexMap::PrewarmTilePool(int32 TargetCount)
+{
+    if (!HexTileClass || !MapCanvas)
+        return;
+    
+    TargetCount = FMath::Min(TargetCount, GetTilePoolCap());
+    const int32 ToCreate = TargetCount - (TilePool.Num() + SpawnedTiles.Num());
+    if (ToCreate <= 0)
+        return;
+    
+    const double StartTime = FPlatformTime::Seconds();
+    
+    TilePool.Reserve(TilePool.Num() + ToCreate);
+    for (int32 i = 0; i < ToCreate; i++)
+    {
+        // Parenting builds the Slate tree and runs NativeConstruct now instead of on first use
+        if (UGW_HexTile* Tile = CreateWidget<UGW_HexTile>(GetOwningPlayer(), HexTileClass))
+        {
+            AddTileToCanvas(Tile);
+            Tile->SetVisibility(ESlateVisibility::Collapsed);
+            TilePool.Add(Tile);
+        }
+    }
+    
+    UE_LOG(LogGrimwardHexMap, Log, TEXT("PrewarmTilePool: created %d tiles in %.2f ms (%d pooled)"),
+        ToCreate, (FPlatformTime::Seconds() - StartTime) * 1000.0, TilePool.Num());
+}
+
+void UGW_ExplorableHexMap::TrimTilePool(int32 MaxPooled)
+{
+    if (TilePool.Num() > MaxPooled)
+    {
+        // Dropped widgets leave the canvas and are collected with the next GC
+        for (int32 i = FMath::Max(MaxPooled, 0); i < TilePool.Num(); i++)
+        {
+            TilePool[i]->RemoveFromParent();
+        }
+        TilePool.SetNum(FMath::Max(MaxPooled, 0));
+    }
+}
+
+void UGW_ExplorableHexMap::ProcessPendingTiles()
+{
+    if (PendingTileCoords.Num() == 0 || !MapGenerator || !MapCanvas)
+        return;
+    
+    // Always make progress on at least one tile per frame
+    int32 Processed = 0;
+    int32 Built = 0;
+    while (Processed < PendingTileCoords.Num() && (Built == 0 || HasTileBuildBudget()))
+    {
+        const FIntPoint Pos = PendingTileCoords[Processed++];
+        if (!TileWindow.Rect.Contains(Pos) || SpawnedTiles.Contains(Pos))
+            continue;
+        
+        UGW_HexTile* NewTile = BuildHexTile(Pos, CurrentMapSeed);
+        if (!NewTile)
+        {
+            // Out of widgets (pool cap): this hex and the rest stay queued as placeholders until tiles free up
+            Processed--;
+            break;
+        }
+        
+        AddTileToScreen(NewTile);
+        Built++;
+    }
+    
+    PendingTileCoords.RemoveAt(0, Processed, EAllowShrinking::No);
+    UpdatePlaceholders();
+}
+
+void UGW_ExplorableHexMap::BeginTileBuildBudget(float BudgetMs)
+{
+    TileBuildDeadline = BudgetMs < 0.0f ? TNumericLimits<double>::Max() : FPlatformTime::Seconds() + BudgetMs * 0.001;
+}
+
+bool UGW_ExplorableHexMap::HasTileBuildBudget() const
+{
+    return FPlatformTime::Seconds() < TileBuildDeadline;
+}
+
+void UGW_ExplorableHexMap::UpdatePlaceholders()
+{
+    if (!PlaceholderCanvas)
+        return;
     
+    PlaceholderCanvas->SetView(ViewportOffset, CurrentZoom, FVector2D(MapConfig.HexWidth, MapConfig.HexHeight));
+    PlaceholderCanvas->SetVisibleRect(TileWindow.Rect);
+    PlaceholderCanvas->SetHexList(PendingTileCoords);
+}
+
+int32 UGW_ExplorableHexMap::CalculateMaxVisibleTileCount() const
+{
     if (!MapGenerator)
-        return VisibleTiles;
+        return 0;
     
-    // TODO: Calculate actual viewport bounds instead of using hardcoded values
-    FVector2D ViewportSize(1920.0f, 1080.0f);
+    // Widest window: minimum zoom, plus the static prefetch margin and a partial hex on each side,
+    // and the longest lookahead on the leading side
+    const FVector2D ViewportSize = GetViewportSize() + FVector2D(MapConfig.PrefetchMargin * 2.0f + MapConfig.PrefetchMaxTravel);
+    const float MinZoom = FMath::Max(MapConfig.ZoomRange.X, KINDA_SMALL_NUMBER);
     
-    // Calculate grid range that's visible
-    FVector2D TopLeft = PixelToGrid(-ViewportOffset / CurrentZoom);
-    FVector2D BottomRight = PixelToGrid((ViewportSize - ViewportOffset) / CurrentZoom);
+    const int32 Columns = FMath::CeilToInt(ViewportSize.X / (MapConfig.HexWidth * 0.75f * MinZoom)) + 2;
+    const int32 Rows = FMath::CeilToInt(ViewportSize.Y / (MapConfig.HexHeight * MinZoom)) + 2;
     
-    int32 MinX = FMath::Max(0, (int32)TopLeft.X - MapConfig.TileRenderBuffer);
-    int32 MaxX = FMath::Min(MapGenerator->GenWidth - 1, (int32)BottomRight.X + MapConfig.TileRenderBuffer);
-    int32 MinY = FMath::Max(0, (int32)TopLeft.Y - MapConfig.TileRenderBuffer);
-    int32 MaxY = FMath::Min(MapGenerator->GenHeight - 1, (int32)BottomRight.Y + MapConfig.TileRenderBuffer);
+    return FMath::Min(Columns, MapGenerator->GenWidth) * FMath::Min(Rows, MapGenerator->GenHeight);
+}
+
+int32 UGW_ExplorableHexMap::GetTilePoolCap() const
+{
+    // A cap below the widest window would leave its last hexes queued as placeholders for good
+    return FMath::Max(MapConfig.MaxPoolSize, CalculateMaxVisibleTileCount());
+}
+
+FVector2D UGW_ExplorableHexMap::GetViewportSize() const
+{
+    // Local size is already in the units the view offset and zoom work in
+    const FVector2D LocalSize = GetCachedGeometry().GetLocalSize();
+    if (!LocalSize.IsNearlyZero())
+    {
+        return LocalSize;
+    }
+    
+    // Not laid out yet (e.g. InitializeMap on the first frame): assume we fill the viewport,
+    // taking the DPI scale out of its pixel size
+    const FVector2D ViewportPixels = UWidgetLayoutLibrary::GetViewportSize(this);
+    const float DPIScale = UWidgetLayoutLibrary::GetViewportScale(this);
+    return DPIScale > 0.0f ? ViewportPixels / DPIScale : ViewportPixels;
+}
+
+void UGW_ExplorableHexMap::LogFrameSummary()
+{
+    LoggedFrames++;
+    if (!UE_LOG_ACTIVE(LogGrimwardHexMap, Verbose) || Stats.VisibilityUpdates == LoggedStats.VisibilityUpdates)
+        return;
+    
+    int32 Suppressed = 0;
+    if (!SummaryLogLimiter.TryLog(Suppressed))
+        return;
+    
+    UE_LOG(LogGrimwardHexMap, Verbose, TEXT("HexMap: %d tiles built (%d pooled, %d created) in %d visibility updates (%.2f ms) over %d frames; %d spawned, %d pending"),
+        Stats.TilesBuilt - LoggedStats.TilesBuilt,
+        Stats.PoolHits - LoggedStats.PoolHits,
+        Stats.PoolMisses - LoggedStats.PoolMisses,
+        Stats.VisibilityUpdates - LoggedStats.VisibilityUpdates,
+        (Stats.VisibilityUpdateSeconds - LoggedStats.VisibilityUpdateSeconds) * 1000.0,
+        LoggedFrames, SpawnedTiles.Num(), PendingTileCoords.Num());
+    
+    LoggedStats = Stats;
+    LoggedFrames = 0;
+}
+
+void UGW_ExplorableHexMap::ResetVisibleTiles()
+{
+    TArray<UGW_HexTile*> Tiles;
+    SpawnedTiles.GenerateValueArray(Tiles);
+    
+    for (UGW_HexTile* Tile : Tiles)
+    {
+        RemoveTileFromScreen(Tile);
+    }
     
-    for (int32 X = MinX; X <= MaxX; ++X)
+    SetActiveTile(nullptr);
+    TileWindow.Reset();
+    PendingTileCoords.Reset();
+    UpdatePlaceholders();
+}
+
+void UGW_ExplorableHexMap::UpdateInteractiveTiles(const FIntRect& VisibleRect)
+{
+    TArray<FIntPoint, TInlineAllocator<2>> NeededTiles;
+    for (const FIntPoint& Pos : { ActiveGridPos, HoveredGridPos })
     {
-        for (int32 Y = MinY; Y <= MaxY; ++Y)
+        if (VisibleRect.Contains(Pos))
+        {
+            NeededTiles.AddUnique(Pos);
+        }
+    }
+    
+    // At most a couple of widgets, so a straight diff is cheapest
+    TArray<UGW_HexTile*, TInlineAllocator<4>> TilesToRemove;
+    for (const auto& Pair : SpawnedTiles)
+    {
+        if (!NeededTiles.Contains(Pair.Key))
+        {
+            TilesToRemove.Add(Pair.Value);
+        }
+    }
+    
+    for (UGW_HexTile* Tile : TilesToRemove)
+    {
+        RemoveTileFromScreen(Tile);
+    }
+    
+    for (const FIntPoint& Pos : NeededTiles)
+    {
+        if (!SpawnedTiles.Contains(Pos))
+        {
+            if (UGW_HexTile* NewTile = BuildHexTile(Pos, CurrentMapSeed))
+            {
+                AddTileToScreen(NewTile);
+            }
+        }
+    }
+}
+
+TArray<FIntPoint> UGW_ExplorableHexMap::CalculateVisibleTileRange() const
+{
+    TArray<FIntPoint> VisibleTiles;
+    
+    const FIntRect VisibleRect = CalculateVisibleGridRect();
+    VisibleTiles.Reserve(VisibleRect.Area());
+    
+    for (int32 X = VisibleRect.Min.X; X < VisibleRect.Max.X; ++X)
+    {
+        for (int32 Y = VisibleRect.Min.Y; Y < VisibleRect.Max.Y; ++Y)
         {
             VisibleTiles.Add(FIntPoint(X, Y));
         }
@@ -449,5 +1285,35 @@ TArray<FIntPoint> UGW_ExplorableHexMap::CalculateVisibleTileRange() const
     
     return VisibleTiles;
 }
+
+FIntRect UGW_ExplorableHexMap::CalculateVisibleGridRect() const
+{
+    if (!MapGenerator)
+        return FIntRect();
+    
+    const double HexWidth = MapConfig.HexWidth;
+    const double HexHeight = MapConfig.HexHeight;
+    const double ColumnSpacing = HexWidth * 0.75;
+    
+    // Visible area in world pixels (inverse of GetScreenPosition)
+    FVector2D ViewMin = -ViewportOffset;
+    FVector2D ViewMax = ViewMin + GetViewportSize() / CurrentZoom;
+    
+    // Static margin on every side, plus the distance the view will travel next frame on the leading side
+    const FVector2D StaticMargin(MapConfig.PrefetchMargin / CurrentZoom);
+    const FVector2D MaxTravel(MapConfig.PrefetchMaxTravel / CurrentZoom);
+    const FVector2D Travel = (-ViewVelocity * LastTickDeltaTime * MapConfig.PrefetchLookaheadFrames).BoundToBox(-MaxTravel, MaxTravel);
+    ViewMin += Travel.ComponentMin(FVector2D::ZeroVector) - StaticMargin;
+    ViewMax += Travel.ComponentMax(FVector2D::ZeroVector) + StaticMargin;
+    
+    // A hex is needed when its box [GridToPixel, GridToPixel + HexSize) overlaps the area;
+    // odd columns sit half a row lower, so the top edge allows for that
+    const int32 MinX = FMath::FloorToInt32((ViewMin.X - HexWidth) / ColumnSpacing) + 1;
+    const int32 MaxX = FMath::CeilToInt32(ViewMax.X / ColumnSpacing);
+    const int32 MinY = FMath::FloorToInt32((ViewMin.Y - HexHeight * 1.5) / HexHeight) + 1;
+    const int32 MaxY = FMath::CeilToInt32(ViewMax.Y / HexHeight);
+    
+    return MapGenerator->ClipRectToMap(FIntRect(MinX, MinY, MaxX, MaxY));
+}
 #pragma endregion
 /*-------------------------------------------------------------------------*/
\ No newline at end of file
@@ -0,0 +1,297 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Core/ExplorationMap/GW_HexMath.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Compile-Time Verification                                              */
+/*-------------------------------------------------------------------------*/
+/**
+ * GW_HexMath is checked here once, at compile time, against a reference that shares
+ * none of its code: adjacency comes straight from hex-centre geometry and distances
+ * from a breadth-first search over that adjacency. A wrong table or formula breaks the build.
+ */
+namespace
+{
+    using namespace GW_HexMath;
+
+    /** Every check covers the square of offsets within BoxRadius of its source hex */
+    constexpr int32 BoxRadius = 6;
+    constexpr int32 BoxSide = BoxRadius * 2 + 1;
+    constexpr int32 BoxCells = BoxSide * BoxSide;
+
+    /** Source hexes of both column parities, including negative coordinates */
+    constexpr int32 NumSources = 6;
+    constexpr int32 SourceColumns[NumSources] = { 0, 1, -1, -4, 7, -9 };
+    constexpr int32 SourceRows[NumSources] = { 0, 0, -1, 3, -5, 11 };
+
+    /**
+     * Reference adjacency from geometry. Scaled so hex centres sit on integers
+     * (X = 3 * column, Y = 2 * row + odd-column shift), neighbouring centres are exactly
+     * one hex width apart, which becomes DX^2 + 3 * DY^2 == 12.
+     */
+    constexpr bool IsReferenceNeighbor(int32 ColumnA, int32 RowA, int32 ColumnB, int32 RowB)
+    {
+        const int32 DX = 3 * (ColumnB - ColumnA);
+        const int32 DY = (2 * RowB + (ColumnB & 1)) - (2 * RowA + (ColumnA & 1));
+        return DX * DX + 3 * DY * DY == 12;
+    }
+
+    /** Breadth-first search distances over the reference adjacency, -1 where unreached */
+    struct FReferenceDistances
+    {
+        int32 SourceColumn = 0;
+        int32 SourceRow = 0;
+        int32 Steps[BoxCells] = {};
+
+        constexpr int32 Get(int32 Column, int32 Row) const
+        {
+            return Steps[(Row - SourceRow + BoxRadius) * BoxSide + (Column - SourceColumn + BoxRadius)];
+        }
+    };
+
+    constexpr FReferenceDistances BuildReferenceDistances(int32 SourceColumn, int32 SourceRow)
+    {
+        FReferenceDistances Result;
+        Result.SourceColumn = SourceColumn;
+        Result.SourceRow = SourceRow;
+        for (int32 i = 0; i < BoxCells; i++)
+        {
+            Result.Steps[i] = -1;
+        }
+
+        int32 Queue[BoxCells] = {};
+        int32 Head = 0;
+        int32 Tail = 0;
+
+        const int32 SourceCell = BoxRadius * BoxSide + BoxRadius;
+        Result.Steps[SourceCell] = 0;
+        Queue[Tail++] = SourceCell;
+
+        while (Head < Tail)
+        {
+            const int32 Cell = Queue[Head++];
+            const int32 CX = Cell % BoxSide;
+            const int32 CY = Cell / BoxSide;
+
+            // Candidates: the 3x3 block around the cell, filtered by geometry
+            for (int32 NY = CY - 1; NY <= CY + 1; NY++)
+            {
+                for (int32 NX = CX - 1; NX <= CX + 1; NX++)
+                {
+                    if (NX < 0 || NY < 0 || NX >= BoxSide || NY >= BoxSide)
+                        continue;
+
+                    const int32 Next = NY * BoxSide + NX;
+                    if (Result.Steps[Next] >= 0)
+                        continue;
+
+                    if (IsReferenceNeighbor(SourceColumn - BoxRadius + CX, SourceRow - BoxRadius + CY,
+                        SourceColumn - BoxRadius + NX, SourceRow - BoxRadius + NY))
+                    {
+                        Result.Steps[Next] = Result.Steps[Cell] + 1;
+                        Queue[Tail++] = Next;
+                    }
+                }
+            }
+        }
+        return Result;
+    }
+
+    /** Offset <-> axial round trip and the implied cube constraint */
+    constexpr bool CheckConversions()
+    {
+        for (int32 Row = -20; Row <= 20; Row++)
+        {
+            for (int32 Column = -20; Column <= 20; Column++)
+            {
+                const FAxial Hex = OffsetToAxial(Column, Row);
+                if (Hex.Q != Column || AxialToOffsetRow(Hex) != Row || Hex.Q + Hex.R + Hex.S() != 0)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /** Both neighbour tables agree with each other and with geometry, six distinct hexes each */
+    constexpr bool CheckNeighbors(int32 Column, int32 Row)
+    {
+        const int32 Parity = Column & 1;
+        for (int32 Dir = 0; Dir < 6; Dir++)
+        {
+            const int32 NX = Column + OffsetNeighborDX[Parity][Dir];
+            const int32 NY = Row + OffsetNeighborDY[Parity][Dir];
+
+            const FAxial Axial = Neighbor(OffsetToAxial(Column, Row), Dir);
+            if (Axial.Q != NX || AxialToOffsetRow(Axial) != NY)
+                return false;
+
+            if (!IsReferenceNeighbor(Column, Row, NX, NY))
+                return false;
+
+            for (int32 Other = 0; Other < Dir; Other++)
+            {
+                if (OffsetNeighborDX[Parity][Other] == OffsetNeighborDX[Parity][Dir]
+                    && OffsetNeighborDY[Parity][Other] == OffsetNeighborDY[Parity][Dir])
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Distance matches the search everywhere a shortest path cannot leave the box
+     * (within BoxRadius steps of the source), and ranges and rings hold exactly the
+     * hexes the search puts at each distance.
+     */
+    constexpr bool CheckDistanceAndIterators(int32 SourceIndex)
+    {
+        const int32 SourceColumn = SourceColumns[SourceIndex];
+        const int32 SourceRow = SourceRows[SourceIndex];
+        const FReferenceDistances Reference = BuildReferenceDistances(SourceColumn, SourceRow);
+        const FAxial Source = OffsetToAxial(SourceColumn, SourceRow);
+
+        if (!CheckNeighbors(SourceColumn, SourceRow))
+            return false;
+
+        int32 ReferenceCounts[BoxRadius + 1] = {};
+        for (int32 Row = SourceRow - BoxRadius; Row <= SourceRow + BoxRadius; Row++)
+        {
+            for (int32 Column = SourceColumn - BoxRadius; Column <= SourceColumn + BoxRadius; Column++)
+            {
+                const int32 Expected = Reference.Get(Column, Row);
+                const int32 Actual = Distance(Source, OffsetToAxial(Column, Row));
+                if ((Expected >= 0 && Expected <= BoxRadius) || Actual <= BoxRadius)
+                {
+                    if (Expected != Actual)
+                        return false;
+
+                    ReferenceCounts[Actual]++;
+                }
+            }
+        }
+
+        for (int32 Radius = 0; Radius <= BoxRadius; Radius++)
+        {
+            if (ReferenceCounts[Radius] != RingCount(Radius))
+                return false;
+
+            // Ring: right count, right distance, each step moves to a neighbour
+            int32 Count = 0;
+            FAxial Previous = Source;
+            FAxial First = Source;
+            for (const FAxial Hex : FRing(Source, Radius))
+            {
+                if (Distance(Source, Hex) != Radius)
+                    return false;
+                if (Count == 0)
+                    First = Hex;
+                else if (Distance(Previous, Hex) != 1)
+                    return false;
+
+                Previous = Hex;
+                Count++;
+            }
+            if (Count != RingCount(Radius) || (Radius > 0 && Distance(Previous, First) != 1))
+                return false;
+
+            // Range: every hex within Radius, and no repeats, so the count proves it is the full set
+            Count = 0;
+            bool Seen[BoxCells] = {};
+            for (const FAxial Hex : FRange(Source, Radius))
+            {
+                if (Distance(Source, Hex) > Radius)
+                    return false;
+
+                const int32 Cell = (AxialToOffsetRow(Hex) - SourceRow + BoxRadius) * BoxSide + (Hex.Q - SourceColumn + BoxRadius);
+                if (Seen[Cell])
+                    return false;
+
+                Seen[Cell] = true;
+                Count++;
+            }
+            if (Count != RangeCount(Radius))
+                return false;
+
+            // Spiral: same set as the range, ordered by distance
+            Count = 0;
+            int32 LastDistance = 0;
+            for (const FAxial Hex : FSpiral(Source, Radius))
+            {
+                const int32 HexDistance = Distance(Source, Hex);
+                if (HexDistance < LastDistance || HexDistance > Radius)
+                    return false;
+
+                LastDistance = HexDistance;
+                Count++;
+            }
+            if (Count != RangeCount(Radius))
+                return false;
+        }
+        return true;
+    }
+
+    /** Lines are unbroken, end on both endpoints and take exactly Distance steps */
+    constexpr bool CheckLines(int32 SourceIndex)
+    {
+        const FAxial Source = OffsetToAxial(SourceColumns[SourceIndex], SourceRows[SourceIndex]);
+        for (const FAxial Target : FRange(Source, 4))
+        {
+            int32 Count = 0;
+            FAxial Previous = Source;
+            for (const FAxial Hex : FLine(Source, Target))
+            {
+                if (Count == 0 ? Hex != Source : Distance(Previous, Hex) != 1)
+                    return false;
+
+                Previous = Hex;
+                Count++;
+            }
+            if (Previous != Target || Count != Distance(Source, Target) + 1)
+                return false;
+        }
+        return true;
+    }
+
+    /** Pixels near every hex centre, at the default 150x130 tile size, round back to that hex */
+    constexpr bool CheckPixelRounding()
+    {
+        constexpr double HexWidth = 150.0;
+        constexpr double HexHeight = 130.0;
+        constexpr double Probe = 0.4 * HexHeight * 0.5;
+
+        constexpr double ProbeX[7] = { 0.0, Probe, -Probe, 0.0, 0.0, Probe * 0.7, -Probe * 0.7 };
+        constexpr double ProbeY[7] = { 0.0, 0.0, 0.0, Probe, -Probe, Probe * 0.7, -Probe * 0.7 };
+
+        for (int32 Row = -8; Row <= 8; Row++)
+        {
+            for (int32 Column = -8; Column <= 8; Column++)
+            {
+                const double CentreX = Column * HexWidth * 0.75 + HexWidth * 0.5;
+                const double CentreY = Row * HexHeight + (Column & 1) * HexHeight * 0.5 + HexHeight * 0.5;
+
+                for (int32 i = 0; i < 7; i++)
+                {
+                    if (PixelToAxial(CentreX + ProbeX[i], CentreY + ProbeY[i], HexWidth, HexHeight) != OffsetToAxial(Column, Row))
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static_assert(CheckConversions(), "GW_HexMath: offset/axial conversion does not round trip");
+    static_assert(CheckNeighbors(0, 0) && CheckNeighbors(1, 0) && CheckNeighbors(-1, -3) && CheckNeighbors(-2, 5),
+        "GW_HexMath: neighbour tables disagree with hex geometry");
+    static_assert(CheckDistanceAndIterators(0), "GW_HexMath: distance or iterators wrong around an even column");
+    static_assert(CheckDistanceAndIterators(1), "GW_HexMath: distance or iterators wrong around an odd column");
+    static_assert(CheckDistanceAndIterators(2), "GW_HexMath: distance or iterators wrong around a negative odd column");
+    static_assert(CheckDistanceAndIterators(3), "GW_HexMath: distance or iterators wrong around a negative even column");
+    static_assert(CheckDistanceAndIterators(4), "GW_HexMath: distance or iterators wrong around (7, -5)");
+    static_assert(CheckDistanceAndIterators(5), "GW_HexMath: distance or iterators wrong around (-9, 11)");
+    static_assert(CheckLines(0) && CheckLines(1) && CheckLines(2) && CheckLines(5), "GW_HexMath: line iterator broken");
+    static_assert(CheckPixelRounding(), "GW_HexMath: pixel to hex rounding misplaces hex centres");
+}
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,432 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Core/ExplorationMap/GW_HexPathfinder.h"
+#include "Core/ExplorationMap/GW_HexMath.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Algo/Reverse.h"
+#include "Grimward.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Functions                                                              */
+/*-------------------------------------------------------------------------*/
+#pragma region FGW_HexTravelRules
+FGW_HexTravelRules::FGW_HexTravelRules()
+{
+    BiomeCosts.Add(EGW_HexBiome::Hill, 2);
+    BiomeCosts.Add(EGW_HexBiome::Forest, 3);
+    BiomeCosts.Add(EGW_HexBiome::Mountain, 5);
+    BiomeCosts.Add(EGW_HexBiome::Desert, 3);
+    BiomeCosts.Add(EGW_HexBiome::Swamp, 4);
+    BiomeCosts.Add(EGW_HexBiome::MysticForest, 3);
+    BiomeCosts.Add(EGW_HexBiome::PoisonousSwamp, 5);
+    BiomeCosts.Add(EGW_HexBiome::DragonBoneyard, 3);
+    BiomeCosts.Add(EGW_HexBiome::Lavascape, 6);
+    BiomeCosts.Add(EGW_HexBiome::IceSpike, 5);
+    BiomeCosts.Add(EGW_HexBiome::GreatPeak, 0);
+    BiomeCosts.Add(EGW_HexBiome::Water, 0);
+    BiomeCosts.Add(EGW_HexBiome::River, 4);
+}
+#pragma endregion
+
+#pragma region GW_HexPathfinder.cpp
+void UGW_HexPathfinder::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    
+    WorldState = Collection.InitializeDependency<UGW_HexWorldState>();
+    if (WorldState)
+    {
+        ExplorationChangedHandle = WorldState->OnExplorationChanged().AddUObject(this, &UGW_HexPathfinder::OnExplorationChanged);
+    }
+    
+    DistanceMaps.Reserve(MaxCachedDistanceMaps);
+    RebuildBiomeCostTable();
+    ResetGrid();
+}
+
+void UGW_HexPathfinder::Deinitialize()
+{
+    if (WorldState)
+    {
+        WorldState->OnExplorationChanged().Remove(ExplorationChangedHandle);
+    }
+    
+    Super::Deinitialize();
+}
+
+// ========================================
+// Setup
+// ========================================
+
+void UGW_HexPathfinder::ResetGrid()
+{
+    MapSize = WorldState ? WorldState->GetMapSize() : FIntPoint::ZeroValue;
+    
+    const int32 NumHexes = MapSize.X * MapSize.Y;
+    TravelCosts.Reset();
+    TravelCosts.Init(Impassable, NumHexes);
+    
+    NodeCost.SetNumUninitialized(NumHexes);
+    NodeParent.SetNumUninitialized(NumHexes);
+    NodeStamp.Reset();
+    NodeStamp.SetNumZeroed(NumHexes);
+    SearchStamp = 0;
+    
+    DistanceMaps.Reset();
+    RefreshTravelCosts(FIntRect(FIntPoint::ZeroValue, MapSize));
+}
+
+void UGW_HexPathfinder::SetTravelRules(const FGW_HexTravelRules& InRules)
+{
+    Rules = InRules;
+    RebuildBiomeCostTable();
+    
+    DistanceMaps.Reset();
+    RefreshTravelCosts(FIntRect(FIntPoint::ZeroValue, MapSize));
+}
+
+void UGW_HexPathfinder::RebuildBiomeCostTable()
+{
+    const int32 NumBiomes = (int32)EGW_HexBiome::River + 1;
+    BiomeCostTable.SetNumUninitialized(NumBiomes);
+    
+    // Leave headroom below Impassable for the hidden surcharge
+    const int32 MaxStepCost = Impassable / 2;
+    
+    MinStepCost = MaxStepCost;
+    for (int32 Biome = 0; Biome < NumBiomes; Biome++)
+    {
+        const int32* Cost = Rules.BiomeCosts.Find((EGW_HexBiome)Biome);
+        const int32 StepCost = Cost ? *Cost : Rules.DefaultCost;
+        
+        if (StepCost <= 0)
+        {
+            BiomeCostTable[Biome] = Impassable;
+            continue;
+        }
+        
+        BiomeCostTable[Biome] = (uint16)FMath::Min(StepCost, MaxStepCost);
+        MinStepCost = FMath::Min(MinStepCost, (int32)BiomeCostTable[Biome]);
+    }
+}
+
+FIntRect UGW_HexPathfinder::RefreshTravelCosts(const FIntRect& Rect)
+{
+    // A resized store is caught in OnExplorationChanged; until then the grid does not match it
+    if (!WorldState || MapSize != WorldState->GetMapSize() || TravelCosts.Num() != MapSize.X * MapSize.Y)
+        return FIntRect();
+    
+    const FIntRect Clipped = WorldState->ClipRectToMap(Rect);
+    const int32 Count = Clipped.Area();
+    if (Count <= 0)
+        return FIntRect();
+    
+    BiomeScratch.SetNumUninitialized(Count, EAllowShrinking::No);
+    WorldState->GetBiomesInRect(Clipped, BiomeScratch);
+    
+    StateScratch.SetNumUninitialized(Count, EAllowShrinking::No);
+    WorldState->GetTileStatesInRect(Clipped, StateScratch);
+    
+    const int32 HiddenExtraCost = FMath::Max(Rules.HiddenExtraCost, 0);
+    
+    FIntPoint ChangedMin(MAX_int32, MAX_int32);
+    FIntPoint ChangedMax(MIN_int32, MIN_int32);
+    
+    int32 ScratchIndex = 0;
+    for (int32 Y = Clipped.Min.Y; Y < Clipped.Max.Y; Y++)
+    {
+        for (int32 X = Clipped.Min.X; X < Clipped.Max.X; X++, ScratchIndex++)
+        {
+            uint16 NewCost = BiomeCostTable[(uint8)BiomeScratch[ScratchIndex]];
+            if (NewCost != Impassable && StateScratch[ScratchIndex] == EGW_HexTileState::Hidden)
+            {
+                NewCost = Rules.bCanEnterHidden
+                    ? (uint16)FMath::Min<int32>(NewCost + HiddenExtraCost, Impassable - 1)
+                    : Impassable;
+            }
+            
+            uint16& Cost = TravelCosts[GetMapIndex(X, Y)];
+            if (Cost != NewCost)
+            {
+                Cost = NewCost;
+                ChangedMin = ChangedMin.ComponentMin(FIntPoint(X, Y));
+                ChangedMax = ChangedMax.ComponentMax(FIntPoint(X + 1, Y + 1));
+            }
+        }
+    }
+    
+    return ChangedMin.X <= ChangedMax.X ? FIntRect(ChangedMin, ChangedMax) : FIntRect();
+}
+
+void UGW_HexPathfinder::OnExplorationChanged(const FIntRect& DirtyRect)
+{
+    // A map of another size was bound; same-size maps arrive as one full-map change below
+    if (WorldState->GetMapSize() != MapSize)
+    {
+        ResetGrid();
+        return;
+    }
+    
+    const FIntRect Changed = RefreshTravelCosts(DirtyRect);
+    if (Changed.Area() <= 0)
+        return;
+    
+    // Only maps whose reach overlaps a changed cost can be stale
+    int32 Invalidated = 0;
+    for (FCachedDistanceMap& Entry : DistanceMaps)
+    {
+        const FIntRect& Bounds = Entry.Map.Bounds;
+        if (Entry.bValid
+            && Bounds.Min.X < Changed.Max.X && Changed.Min.X < Bounds.Max.X
+            && Bounds.Min.Y < Changed.Max.Y && Changed.Min.Y < Bounds.Max.Y)
+        {
+            Entry.bValid = false;
+            Invalidated++;
+        }
+    }
+    
+    UE_LOG(LogGrimward, Verbose, TEXT("HexPathfinder: costs changed in %dx%d hexes, %d distance maps invalidated"),
+        Changed.Width(), Changed.Height(), Invalidated);
+}
+
+// ========================================
+// Queries
+// ========================================
+
+int32 UGW_HexPathfinder::GetTravelCost(FIntPoint GridPos) const
+{
+    if (GridPos.X < 0 || GridPos.Y < 0 || GridPos.X >= MapSize.X || GridPos.Y >= MapSize.Y || TravelCosts.Num() == 0)
+        return -1;
+    
+    const uint16 Cost = TravelCosts[GetMapIndex(GridPos.X, GridPos.Y)];
+    return Cost == Impassable ? -1 : Cost;
+}
+
+bool UGW_HexPathfinder::FindPath(FIntPoint Start, FIntPoint Goal, TArray<FIntPoint>& OutPath, int32& OutCost)
+{
+    OutPath.Reset();
+    OutCost = 0;
+    
+    // The start may sit on impassable terrain (it is never entered); the goal may not
+    const bool bStartOnMap = Start.X >= 0 && Start.Y >= 0 && Start.X < MapSize.X && Start.Y < MapSize.Y;
+    if (!bStartOnMap || TravelCosts.Num() == 0 || (Start != Goal && GetTravelCost(Goal) < 0))
+    {
+        return false;
+    }
+    
+    // A new stamp invalidates the whole node pool without touching it
+    if (++SearchStamp == 0)
+    {
+        FMemory::Memzero(NodeStamp.GetData(), NodeStamp.Num() * sizeof(uint32));
+        SearchStamp = 1;
+    }
+    
+    const GW_HexMath::FAxial GoalAxial = GW_HexMath::ToAxial(Goal);
+    const int32 StartIndex = GetMapIndex(Start.X, Start.Y);
+    const int32 GoalIndex = GetMapIndex(Goal.X, Goal.Y);
+    
+    NodeStamp[StartIndex] = SearchStamp;
+    NodeCost[StartIndex] = 0;
+    NodeParent[StartIndex] = INDEX_NONE;
+    
+    OpenHeap.Reset();
+    OpenHeap.HeapPush(FOpenNode{ GW_HexMath::Distance(GW_HexMath::ToAxial(Start), GoalAxial) * MinStepCost, 0, StartIndex });
+    
+    bool bFound = false;
+    while (OpenHeap.Num() > 0)
+    {
+        FOpenNode Node;
+        OpenHeap.HeapPop(Node, EAllowShrinking::No);
+        
+        // Superseded by a cheaper entry pushed later
+        if (Node.Cost > NodeCost[Node.Index])
+            continue;
+        
+        if (Node.Index == GoalIndex)
+        {
+            bFound = true;
+            break;
+        }
+        
+        const int32 CX = Node.Index % MapSize.X;
+        const int32 CY = Node.Index / MapSize.X;
+        const int32 Parity = CX & 1;
+        for (int32 Dir = 0; Dir < 6; Dir++)
+        {
+            const int32 NX = CX + GW_HexMath::OffsetNeighborDX[Parity][Dir];
+            const int32 NY = CY + GW_HexMath::OffsetNeighborDY[Parity][Dir];
+            if (NX < 0 || NY < 0 || NX >= MapSize.X || NY >= MapSize.Y)
+                continue;
+            
+            const int32 Next = GetMapIndex(NX, NY);
+            const uint16 StepCost = TravelCosts[Next];
+            if (StepCost == Impassable)
+                continue;
+            
+            const int32 NewCost = Node.Cost + StepCost;
+            if (NodeStamp[Next] == SearchStamp && NodeCost[Next] <= NewCost)
+                continue;
+            
+            NodeStamp[Next] = SearchStamp;
+            NodeCost[Next] = NewCost;
+            NodeParent[Next] = Node.Index;
+            
+            const int32 Heuristic = GW_HexMath::Distance(GW_HexMath::OffsetToAxial(NX, NY), GoalAxial) * MinStepCost;
+            OpenHeap.HeapPush(FOpenNode{ NewCost + Heuristic, NewCost, Next });
+        }
+    }
+    
+    if (!bFound)
+        return false;
+    
+    for (int32 Index = GoalIndex; Index != INDEX_NONE; Index = NodeParent[Index])
+    {
+        OutPath.Add(FIntPoint(Index % MapSize.X, Index / MapSize.X));
+    }
+    Algo::Reverse(OutPath);
+    
+    OutCost = NodeCost[GoalIndex];
+    return true;
+}
+
+const FGW_HexDistanceMap& UGW_HexPathfinder::GetDistanceMap(TArrayView<const FIntPoint> Sources, int32 Budget)
+{
+    DistanceMapUseCounter++;
+    Budget = FMath::Max(Budget, 0);
+    
+    auto HasSources = [&Sources](const FGW_HexDistanceMap& Map)
+    {
+        if (Map.Sources.Num() != Sources.Num())
+            return false;
+        
+        for (int32 i = 0; i < Sources.Num(); i++)
+        {
+            if (Map.Sources[i] != Sources[i])
+                return false;
+        }
+        return true;
+    };
+    
+    FCachedDistanceMap* Slot = nullptr;
+    for (FCachedDistanceMap& Entry : DistanceMaps)
+    {
+        if (Entry.bValid && Entry.Map.Budget == Budget && HasSources(Entry.Map))
+        {
+            Entry.LastUsed = DistanceMapUseCounter;
+            return Entry.Map;
+        }
+        
+        // Prefer a stale entry, then the least recently used one
+        if (!Slot || (Slot->bValid && (!Entry.bValid || Entry.LastUsed < Slot->LastUsed)))
+        {
+            Slot = &Entry;
+        }
+    }
+    
+    if (DistanceMaps.Num() < MaxCachedDistanceMaps && (!Slot || Slot->bValid))
+    {
+        Slot = &DistanceMaps.AddDefaulted_GetRef();
+    }
+    
+    Slot->Map.Sources.Reset();
+    Slot->Map.Sources.Append(Sources.GetData(), Sources.Num());
+    Slot->Map.Budget = Budget;
+    Slot->LastUsed = DistanceMapUseCounter;
+    Slot->bValid = true;
+    
+    BuildDistanceMap(Slot->Map);
+    return Slot->Map;
+}
+
+void UGW_HexPathfinder::BuildDistanceMap(FGW_HexDistanceMap& Map)
+{
+    Map.Bounds = FIntRect();
+    Map.Costs.Reset();
+    
+    FIntPoint SourceMin(MAX_int32, MAX_int32);
+    FIntPoint SourceMax(MIN_int32, MIN_int32);
+    for (const FIntPoint& Source : Map.Sources)
+    {
+        if (Source.X >= 0 && Source.Y >= 0 && Source.X < MapSize.X && Source.Y < MapSize.Y)
+        {
+            SourceMin = SourceMin.ComponentMin(Source);
+            SourceMax = SourceMax.ComponentMax(Source);
+        }
+    }
+    
+    if (SourceMin.X > SourceMax.X || !WorldState)
+        return;
+    
+    // Each step moves at most one column and one row, and costs at least MinStepCost
+    const int32 MaxSteps = Map.Budget / MinStepCost;
+    Map.Bounds = WorldState->ClipRectToMap(FIntRect(SourceMin - FIntPoint(MaxSteps, MaxSteps), SourceMax + FIntPoint(MaxSteps + 1, MaxSteps + 1)));
+    
+    const int32 BoundsWidth = Map.Bounds.Width();
+    Map.Costs.Init(FGW_HexDistanceMap::Unreachable, Map.Bounds.Area());
+    
+    OpenHeap.Reset();
+    for (const FIntPoint& Source : Map.Sources)
+    {
+        if (Map.Bounds.Contains(Source))
+        {
+            const int32 Local = (Source.Y - Map.Bounds.Min.Y) * BoundsWidth + (Source.X - Map.Bounds.Min.X);
+            Map.Costs[Local] = 0;
+            OpenHeap.HeapPush(FOpenNode{ 0, 0, Local });
+        }
+    }
+    
+    while (OpenHeap.Num() > 0)
+    {
+        FOpenNode Node;
+        OpenHeap.HeapPop(Node, EAllowShrinking::No);
+        
+        if (Node.Cost > Map.Costs[Node.Index])
+            continue;
+        
+        const int32 CX = Map.Bounds.Min.X + Node.Index % BoundsWidth;
+        const int32 CY = Map.Bounds.Min.Y + Node.Index / BoundsWidth;
+        const int32 Parity = CX & 1;
+        for (int32 Dir = 0; Dir < 6; Dir++)
+        {
+            const FIntPoint Neighbor(CX + GW_HexMath::OffsetNeighborDX[Parity][Dir], CY + GW_HexMath::OffsetNeighborDY[Parity][Dir]);
+            if (!Map.Bounds.Contains(Neighbor))
+                continue;
+            
+            const uint16 StepCost = TravelCosts[GetMapIndex(Neighbor.X, Neighbor.Y)];
+            if (StepCost == Impassable)
+                continue;
+            
+            const int32 NewCost = Node.Cost + StepCost;
+            const int32 Local = (Neighbor.Y - Map.Bounds.Min.Y) * BoundsWidth + (Neighbor.X - Map.Bounds.Min.X);
+            if (NewCost > Map.Budget || NewCost >= Map.Costs[Local])
+                continue;
+            
+            Map.Costs[Local] = NewCost;
+            OpenHeap.HeapPush(FOpenNode{ NewCost, NewCost, Local });
+        }
+    }
+}
+
+int32 UGW_HexPathfinder::GetReachableHexes(const TArray<FIntPoint>& Sources, int32 Budget, TArray<FIntPoint>& OutHexes)
+{
+    OutHexes.Reset();
+    
+    const FGW_HexDistanceMap& Map = GetDistanceMap(Sources, Budget);
+    int32 CostIndex = 0;
+    for (int32 Y = Map.Bounds.Min.Y; Y < Map.Bounds.Max.Y; Y++)
+    {
+        for (int32 X = Map.Bounds.Min.X; X < Map.Bounds.Max.X; X++, CostIndex++)
+        {
+            if (Map.Costs[CostIndex] != FGW_HexDistanceMap::Unreachable)
+            {
+                OutHexes.Add(FIntPoint(X, Y));
+            }
+        }
+    }
+    return OutHexes.Num();
+}
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,299 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Core/ExplorationMap/GW_HexRevealService.h"
+#include "Core/ExplorationMap/GW_HexMath.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Grimward.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Functions                                                              */
+/*-------------------------------------------------------------------------*/
+#pragma region FGW_HexSightRules
+FGW_HexSightRules::FGW_HexSightRules()
+{
+    OccludingBiomes.Add(EGW_HexBiome::Mountain);
+    OccludingBiomes.Add(EGW_HexBiome::GreatPeak);
+}
+#pragma endregion
+
+#pragma region GW_HexRevealService.cpp
+void UGW_HexRevealService::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    
+    WorldState = Collection.InitializeDependency<UGW_HexWorldState>();
+    if (WorldState)
+    {
+        ExplorationChangedHandle = WorldState->OnExplorationChanged().AddUObject(this, &UGW_HexRevealService::OnExplorationChanged);
+    }
+    
+    ResetOccluders();
+}
+
+void UGW_HexRevealService::Deinitialize()
+{
+    if (WorldState)
+    {
+        WorldState->OnExplorationChanged().Remove(ExplorationChangedHandle);
+    }
+    
+    Super::Deinitialize();
+}
+
+// ========================================
+// Setup
+// ========================================
+
+void UGW_HexRevealService::SetSightRules(const FGW_HexSightRules& InRules)
+{
+    Rules = InRules;
+    ResetOccluders();
+}
+
+void UGW_HexRevealService::OnExplorationChanged(const FIntRect& DirtyRect)
+{
+    // A map of another size was bound; same-size maps arrive as one full-map change
+    if (WorldState->GetMapSize() != MapSize)
+    {
+        ResetOccluders();
+        return;
+    }
+    
+    RefreshOccluders(DirtyRect);
+}
+
+void UGW_HexRevealService::ResetOccluders()
+{
+    MapSize = WorldState ? WorldState->GetMapSize() : FIntPoint::ZeroValue;
+    Occluders.Init(false, MapSize.X * MapSize.Y);
+    RefreshOccluders(FIntRect(FIntPoint::ZeroValue, MapSize));
+}
+
+void UGW_HexRevealService::RefreshOccluders(const FIntRect& Rect)
+{
+    if (!WorldState || Occluders.Num() != MapSize.X * MapSize.Y)
+        return;
+    
+    const FIntRect Clipped = WorldState->ClipRectToMap(Rect);
+    const int32 Count = Clipped.Area();
+    if (Count <= 0)
+        return;
+    
+    bool bOccludes[(int32)EGW_HexBiome::River + 1] = {};
+    for (const EGW_HexBiome Biome : Rules.OccludingBiomes)
+    {
+        bOccludes[(uint8)Biome] = true;
+    }
+    
+    BiomeScratch.SetNumUninitialized(Count, EAllowShrinking::No);
+    WorldState->GetBiomesInRect(Clipped, BiomeScratch);
+    
+    int32 BiomeIndex = 0;
+    for (int32 Y = Clipped.Min.Y; Y < Clipped.Max.Y; Y++)
+    {
+        for (int32 X = Clipped.Min.X; X < Clipped.Max.X; X++, BiomeIndex++)
+        {
+            Occluders[Y * MapSize.X + X] = bOccludes[(uint8)BiomeScratch[BiomeIndex]];
+        }
+    }
+}
+
+// ========================================
+// Queries
+// ========================================
+
+bool UGW_HexRevealService::IsOccluder(FIntPoint GridPos) const
+{
+    return IsOnMap(GridPos) && Occluders.Num() > 0 && Occluders[GridPos.Y * MapSize.X + GridPos.X];
+}
+
+bool UGW_HexRevealService::HasLineOfSight(FIntPoint From, FIntPoint To) const
+{
+    const GW_HexMath::FAxial Target = GW_HexMath::ToAxial(To);
+    const GW_HexMath::FAxial Start = GW_HexMath::ToAxial(From);
+    
+    for (const GW_HexMath::FAxial Hex : GW_HexMath::FLine(Start, Target))
+    {
+        if (Hex != Start && Hex != Target && IsOccluder(GW_HexMath::ToOffset(Hex)))
+            return false;
+    }
+    return true;
+}
+
+template<typename FuncType>
+int32 UGW_HexRevealService::CastFieldOfView(FIntPoint Origin, int32 Radius, FuncType&& Visit)
+{
+    if (!IsOnMap(Origin) || Radius < 0)
+        return 0;
+    
+    // Standing on an occluder does not block the view out of it
+    Visit(Origin);
+    int32 Count = 1;
+    
+    Shadows.Reset();
+    const GW_HexMath::FAxial Center = GW_HexMath::ToAxial(Origin);
+    for (int32 Ring = 1; Ring <= Radius && !IsFullyShadowed(); Ring++)
+    {
+        // Rings all start at the same corner, so index / hexes-in-ring is a consistent angle
+        const double Slice = 1.0 / GW_HexMath::RingCount(Ring);
+        
+        // Shadows cast on this ring only apply to rings further out
+        TArray<FVector2D, TInlineAllocator<16>> RingShadows;
+        
+        int32 Index = 0;
+        for (const GW_HexMath::FAxial Hex : GW_HexMath::FRing(Center, Ring))
+        {
+            const double Angle = Index * Slice;
+            const FIntPoint GridPos = GW_HexMath::ToOffset(Hex);
+            Index++;
+            
+            if (!IsOnMap(GridPos) || IsInShadow(Angle))
+                continue;
+            
+            Visit(GridPos);
+            Count++;
+            
+            if (IsOccluder(GridPos))
+            {
+                RingShadows.Add(FVector2D(Angle - Slice * 0.5, Angle + Slice * 0.5));
+            }
+        }
+        
+        for (const FVector2D& Shadow : RingShadows)
+        {
+            AddShadow(Shadow.X, Shadow.Y);
+        }
+    }
+    return Count;
+}
+
+int32 UGW_HexRevealService::ComputeFieldOfView(FIntPoint Origin, int32 Radius, TArray<FIntPoint>& OutVisible)
+{
+    OutVisible.Reset();
+    return CastFieldOfView(Origin, Radius, [&OutVisible](FIntPoint GridPos)
+    {
+        OutVisible.Add(GridPos);
+    });
+}
+
+FIntRect UGW_HexRevealService::GetSightBounds(FIntPoint Origin, int32 Radius) const
+{
+    // In odd-q offsets a range never leaves Origin +/- Radius on either axis
+    return FIntRect(
+        FIntPoint(Origin.X - Radius, Origin.Y - Radius).ComponentMax(FIntPoint::ZeroValue),
+        FIntPoint(Origin.X + Radius + 1, Origin.Y + Radius + 1).ComponentMin(MapSize));
+}
+
+// ========================================
+// Reveal
+// ========================================
+
+int32 UGW_HexRevealService::RevealFrom(FIntPoint Origin, int32 Radius)
+{
+    return RevealFromOrigins(MakeArrayView(&Origin, 1), Radius);
+}
+
+int32 UGW_HexRevealService::RevealFromMany(const TArray<FIntPoint>& Origins, int32 Radius)
+{
+    return RevealFromOrigins(Origins, Radius);
+}
+
+int32 UGW_HexRevealService::RevealFromOrigins(TArrayView<const FIntPoint> Origins, int32 Radius)
+{
+    if (!WorldState || WorldState->GetMapSize() != MapSize || Radius < 0)
+        return 0;
+    
+    // One mask over the union of every origin's reach
+    FIntPoint BoundsMin(MAX_int32, MAX_int32);
+    FIntPoint BoundsMax(MIN_int32, MIN_int32);
+    for (const FIntPoint& Origin : Origins)
+    {
+        if (IsOnMap(Origin))
+        {
+            const FIntRect Bounds = GetSightBounds(Origin, Radius);
+            BoundsMin = BoundsMin.ComponentMin(Bounds.Min);
+            BoundsMax = BoundsMax.ComponentMax(Bounds.Max);
+        }
+    }
+    
+    if (BoundsMin.X >= BoundsMax.X)
+        return 0;
+    
+    FGW_HexRevealMask Mask;
+    Mask.Init(FIntRect(BoundsMin, BoundsMax));
+    
+    int32 Seen = 0;
+    for (const FIntPoint& Origin : Origins)
+    {
+        Seen += CastFieldOfView(Origin, Radius, [&Mask](FIntPoint GridPos)
+        {
+            Mask.Add(GridPos);
+        });
+    }
+    
+    WorldState->Reveal(Mask);
+    
+    UE_LOG(LogGrimward, Verbose, TEXT("HexRevealService: %d origins saw %d hexes (radius %d)"), Origins.Num(), Seen, Radius);
+    return Seen;
+}
+
+// ========================================
+// Shadows
+// ========================================
+
+bool UGW_HexRevealService::IsInShadow(double Angle) const
+{
+    // A centre exactly on a shadow edge stays lit, so sight is symmetric around occluders.
+    // No hex arc starts at exactly 0, so an arc starting there is the wrapped half of one
+    // straddling the start corner and 0 is inside it, not on its edge.
+    for (const FVector2D& Shadow : Shadows)
+    {
+        const bool bWrapSeam = Shadow.X <= ShadowTolerance;
+        if (Angle <= Shadow.X + ShadowTolerance && !bWrapSeam)
+            return false;
+        
+        if (Angle < Shadow.Y - ShadowTolerance)
+            return true;
+    }
+    return false;
+}
+
+void UGW_HexRevealService::AddShadow(double Start, double End)
+{
+    if (Start < 0.0)
+    {
+        AddShadow(Start + 1.0, 1.0);
+        Start = 0.0;
+    }
+    
+    // Insert in order, then fold in every arc it now touches
+    int32 Insert = 0;
+    while (Insert < Shadows.Num() && Shadows[Insert].X < Start)
+    {
+        Insert++;
+    }
+    Shadows.Insert(FVector2D(Start, End), Insert);
+    
+    if (Insert > 0 && Shadows[Insert - 1].Y + ShadowTolerance >= Start)
+    {
+        Insert--;
+        Shadows[Insert].Y = FMath::Max(Shadows[Insert].Y, End);
+        Shadows.RemoveAt(Insert + 1, EAllowShrinking::No);
+    }
+    
+    while (Insert + 1 < Shadows.Num() && Shadows[Insert + 1].X <= Shadows[Insert].Y + ShadowTolerance)
+    {
+        Shadows[Insert].Y = FMath::Max(Shadows[Insert].Y, Shadows[Insert + 1].Y);
+        Shadows.RemoveAt(Insert + 1, EAllowShrinking::No);
+    }
+}
+
+bool UGW_HexRevealService::IsFullyShadowed() const
+{
+    return Shadows.Num() == 1 && Shadows[0].X <= ShadowTolerance && Shadows[0].Y >= 1.0 - ShadowTolerance;
+}
+#pragma endregion
+/*-------------------------------------------------------------------------*/
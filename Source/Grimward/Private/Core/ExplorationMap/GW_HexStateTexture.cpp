@@ -0,0 +1,168 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Core/ExplorationMap/GW_HexStateTexture.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "Engine/Texture2D.h"
+#include "Core/GW_Logging.h"
+#include "Grimward.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Functions                                                              */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexStateTexture.cpp
+namespace
+{
+    constexpr int32 NumBiomes = (int32)EGW_HexBiome::River + 1;
+}
+
+void FGW_HexStateTexture::SetTints(const FLinearColor& HiddenTint, const FLinearColor& ExploredTint, const FLinearColor& ConqueredTint)
+{
+    Tints[(int32)EGW_HexTileState::Hidden] = HiddenTint;
+    Tints[(int32)EGW_HexTileState::Explored] = ExploredTint;
+    Tints[(int32)EGW_HexTileState::Conquered] = ConqueredTint;
+}
+
+bool FGW_HexStateTexture::Rebuild(const UGW_HexWorldState* WorldState, TextureFilter Filter)
+{
+    PendingRegions.Reset();
+    
+    const FIntPoint MapSize = WorldState ? WorldState->GetMapSize() : FIntPoint::ZeroValue;
+    if (MapSize.X <= 0 || MapSize.Y <= 0)
+    {
+        Reset();
+        return false;
+    }
+    
+    if (!Texture || Size != MapSize)
+    {
+        Texture = UTexture2D::CreateTransient(MapSize.X, MapSize.Y, PF_B8G8R8A8);
+        if (!Texture)
+        {
+            UE_LOG(LogGrimward, Error, TEXT("HexStateTexture: Failed to create a %dx%d texture!"), MapSize.X, MapSize.Y);
+            Size = FIntPoint::ZeroValue;
+            return false;
+        }
+        
+        Size = MapSize;
+    }
+    Texture->Filter = Filter;
+    
+    // Hidden, Explored, Conquered rows of NumBiomes colours each
+    ColorTable.SetNumUninitialized(3 * NumBiomes);
+    for (int32 State = 0; State < 3; State++)
+    {
+        const FLinearColor& Tint = Tints[State];
+        for (int32 Biome = 0; Biome < NumBiomes; Biome++)
+        {
+            const FLinearColor BiomeColor(AGW_MapGenerator::GetColorForBiome((EGW_HexBiome)Biome));
+            const FLinearColor Blended = FMath::Lerp(BiomeColor, FLinearColor(Tint.R, Tint.G, Tint.B, 1.0f), Tint.A);
+            ColorTable[State * NumBiomes + Biome] = Blended.ToFColor(true);
+        }
+    }
+    
+    // The only full pass: everything after this is uploaded per changed region
+    FTexture2DMipMap& Mip = Texture->GetPlatformData()->Mips[0];
+    FColor* Texels = static_cast<FColor*>(Mip.BulkData.Lock(LOCK_READ_WRITE));
+    FillTexels(WorldState, FIntRect(FIntPoint::ZeroValue, Size), Texels, Size.X);
+    Mip.BulkData.Unlock();
+    Texture->UpdateResource();
+    
+    return true;
+}
+
+void FGW_HexStateTexture::Reset()
+{
+    Texture = nullptr;
+    Size = FIntPoint::ZeroValue;
+    PendingRegions.Reset();
+}
+
+void FGW_HexStateTexture::AddPendingRegion(const FIntRect& Region)
+{
+    const FIntRect Clipped(Region.Min.ComponentMax(FIntPoint::ZeroValue), Region.Max.ComponentMin(Size));
+    if (Clipped.Min.X >= Clipped.Max.X || Clipped.Min.Y >= Clipped.Max.Y)
+        return;
+    
+    for (FIntRect& Pending : PendingRegions)
+    {
+        if (Pending.Intersect(Clipped))
+        {
+            Pending.Union(Clipped);
+            return;
+        }
+    }
+    
+    // Out of slots: grow the last region instead, which only costs extra texels
+    if (PendingRegions.Num() >= MaxPendingRegions)
+    {
+        PendingRegions.Last().Union(Clipped);
+        return;
+    }
+    
+    PendingRegions.Add(Clipped);
+}
+
+void FGW_HexStateTexture::Flush(const UGW_HexWorldState* WorldState)
+{
+    if (PendingRegions.Num() == 0 || !Texture)
+        return;
+    
+    // Stack the regions in one staging buffer, each starting at column 0 of its own rows
+    int32 Pitch = 0;
+    int32 TotalRows = 0;
+    for (const FIntRect& Region : PendingRegions)
+    {
+        Pitch = FMath::Max(Pitch, Region.Width());
+        TotalRows += Region.Height();
+    }
+    
+    // Owned by the render thread until the upload is done; freed by the cleanup callback
+    uint8* Staging = new uint8[Pitch * TotalRows * sizeof(FColor)];
+    FUpdateTextureRegion2D* Regions = new FUpdateTextureRegion2D[PendingRegions.Num()];
+    
+    int32 Row = 0;
+    for (int32 i = 0; i < PendingRegions.Num(); i++)
+    {
+        const FIntRect& Region = PendingRegions[i];
+        FillTexels(WorldState, Region, reinterpret_cast<FColor*>(Staging) + Row * Pitch, Pitch);
+        Regions[i] = FUpdateTextureRegion2D(Region.Min.X, Region.Min.Y, 0, Row, Region.Width(), Region.Height());
+        Row += Region.Height();
+    }
+    
+    Texture->UpdateTextureRegions(0, PendingRegions.Num(), Regions, Pitch * sizeof(FColor), sizeof(FColor), Staging,
+        [](uint8* SrcData, const FUpdateTextureRegion2D* SrcRegions)
+        {
+            delete[] SrcData;
+            delete[] SrcRegions;
+        });
+    
+    GW_LOG_RATE_LIMITED(LogGrimwardHexMap, Verbose, 1.0f, TEXT("HexStateTexture: Uploaded %d regions (%d texels)"), PendingRegions.Num(), Pitch * TotalRows);
+    PendingRegions.Reset();
+}
+
+void FGW_HexStateTexture::FillTexels(const UGW_HexWorldState* WorldState, const FIntRect& Rect, FColor* Dest, int32 Pitch)
+{
+    if (!WorldState || ColorTable.Num() == 0)
+        return;
+    
+    StateScratch.SetNumUninitialized(Rect.Width(), EAllowShrinking::No);
+    BiomeScratch.SetNumUninitialized(Rect.Width(), EAllowShrinking::No);
+    for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; Y++)
+    {
+        const FIntRect RowRect(Rect.Min.X, Y, Rect.Max.X, Y + 1);
+        WorldState->GetTileStatesInRect(RowRect, StateScratch);
+        WorldState->GetBiomesInRect(RowRect, BiomeScratch);
+        
+        FColor* RowTexels = Dest + (Y - Rect.Min.Y) * Pitch;
+        for (int32 i = 0; i < Rect.Width(); i++)
+        {
+            RowTexels[i] = ColorTable[(int32)StateScratch[i] * NumBiomes + (int32)BiomeScratch[i]];
+        }
+    }
+}
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,106 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Core/ExplorationMap/GW_HexVisualsAsset.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/Texture2D.h"
+#include "Grimward.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Functions                                                              */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexVisualsAsset.cpp
+namespace
+{
+    template<typename KeyType>
+    void BuildAtlasBrushes(UTexture2D* Atlas, const TMap<KeyType, FGW_HexAtlasRegion>& Regions, TMap<KeyType, FSlateBrush>& OutBrushes)
+    {
+        OutBrushes.Reset();
+        if (!Atlas)
+            return;
+        
+        const FVector2D AtlasSize(Atlas->GetSizeX(), Atlas->GetSizeY());
+        
+        for (const auto& Pair : Regions)
+        {
+            const FGW_HexAtlasRegion& Region = Pair.Value;
+            
+            FSlateBrush& Brush = OutBrushes.Add(Pair.Key);
+            Brush.SetResourceObject(Atlas);
+            Brush.SetUVRegion(FBox2f(FVector2f(Region.UVMin), FVector2f(Region.UVMax)));
+            Brush.SetImageSize(AtlasSize * (Region.UVMax - Region.UVMin));
+        }
+    }
+}
+
+void UGW_HexVisualsAsset::RequestAsyncLoad(FSimpleDelegate OnLoaded)
+{
+    if (bBrushesBuilt)
+    {
+        OnLoaded.ExecuteIfBound();
+        return;
+    }
+    
+    PendingCallbacks.Add(MoveTemp(OnLoaded));
+    
+    // A load is already in flight, it will pick up the new callback
+    if (LoadHandle.IsValid() && LoadHandle->IsLoadingInProgress())
+        return;
+    
+    TArray<FSoftObjectPath> AtlasPaths;
+    if (!BiomeAtlas.IsNull())
+    {
+        AtlasPaths.Add(BiomeAtlas.ToSoftObjectPath());
+    }
+    if (!POIAtlas.IsNull())
+    {
+        AtlasPaths.Add(POIAtlas.ToSoftObjectPath());
+    }
+    
+    if (AtlasPaths.Num() == 0)
+    {
+        UE_LOG(LogGrimward, Warning, TEXT("UGW_HexVisualsAsset %s has no atlases assigned"), *GetName());
+        OnAtlasesLoaded();
+        return;
+    }
+    
+    LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AtlasPaths,
+        FStreamableDelegate::CreateUObject(this, &UGW_HexVisualsAsset::OnAtlasesLoaded));
+}
+
+const FSlateBrush* UGW_HexVisualsAsset::GetBiomeBrush(EGW_HexBiome Biome) const
+{
+    return BiomeBrushes.Find(Biome);
+}
+
+const FSlateBrush* UGW_HexVisualsAsset::GetPOIBrush(EGW_HexPOI POI) const
+{
+    return POIBrushes.Find(POI);
+}
+
+void UGW_HexVisualsAsset::BuildBrushCache()
+{
+    BuildAtlasBrushes(BiomeAtlas.Get(), BiomeRegions, BiomeBrushes);
+    BuildAtlasBrushes(POIAtlas.Get(), POIRegions, POIBrushes);
+    bBrushesBuilt = true;
+    
+    UE_LOG(LogGrimward, Log, TEXT("UGW_HexVisualsAsset %s: cached %d biome and %d POI brushes"),
+        *GetName(), BiomeBrushes.Num(), POIBrushes.Num());
+}
+
+void UGW_HexVisualsAsset::OnAtlasesLoaded()
+{
+    BuildBrushCache();
+    
+    // Callbacks may request another load, so work from a local copy
+    TArray<FSimpleDelegate> Callbacks = MoveTemp(PendingCallbacks);
+    for (FSimpleDelegate& Callback : Callbacks)
+    {
+        Callback.ExecuteIfBound();
+    }
+}
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,672 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Core/ExplorationMap/GW_HexMath.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "Core/GW_SaveGame.h"
+#include "Grimward.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Helpers                                                                */
+/*-------------------------------------------------------------------------*/
+namespace GW_ExplorationSave
+{
+    enum class ERowMode : uint8
+    {
+        Runs,
+        Packed
+    };
+    
+    static void WriteVarInt(TArray<uint8>& Out, uint32 Value)
+    {
+        while (Value >= 0x80)
+        {
+            Out.Add(uint8(Value | 0x80));
+            Value >>= 7;
+        }
+        Out.Add(uint8(Value));
+    }
+    
+    static bool ReadVarInt(TArrayView<const uint8> In, int32& Offset, uint32& OutValue)
+    {
+        OutValue = 0;
+        for (int32 Shift = 0; Shift < 32 && Offset < In.Num(); Shift += 7)
+        {
+            const uint8 Byte = In[Offset++];
+            OutValue |= uint32(Byte & 0x7F) << Shift;
+            if ((Byte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+}
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Functions                                                              */
+/*-------------------------------------------------------------------------*/
+#pragma region FGW_HexRevealMask
+void FGW_HexRevealMask::Init(const FIntRect& InBounds)
+{
+    Bounds = InBounds;
+    Words.Reset();
+    WordsPerRow = 0;
+    
+    if (Bounds.Width() <= 0 || Bounds.Height() <= 0)
+        return;
+    
+    // Word columns line up with the store's chunk columns
+    const int32 FirstWord = Bounds.Min.X / UGW_HexWorldState::ChunkSize;
+    const int32 LastWord = (Bounds.Max.X - 1) / UGW_HexWorldState::ChunkSize;
+    WordsPerRow = LastWord - FirstWord + 1;
+    Words.SetNumZeroed(WordsPerRow * Bounds.Height());
+}
+
+void FGW_HexRevealMask::Add(FIntPoint GridPos)
+{
+    if (!Bounds.Contains(GridPos))
+        return;
+    
+    const int32 WordX = GridPos.X / UGW_HexWorldState::ChunkSize - Bounds.Min.X / UGW_HexWorldState::ChunkSize;
+    const int32 Shift = (GridPos.X % UGW_HexWorldState::ChunkSize) * UGW_HexWorldState::BitsPerHex;
+    Words[(GridPos.Y - Bounds.Min.Y) * WordsPerRow + WordX] |= uint64(1) << Shift;
+}
+#pragma endregion
+
+#pragma region GW_HexWorldState.cpp
+bool UGW_HexWorldState::BindMap(AGW_MapGenerator* MapGenerator)
+{
+    if (!MapGenerator)
+        return false;
+    
+    // The key only rules out most maps quickly; equal params are what make it the same map
+    const FGW_MapGenerationParams& NewParams = MapGenerator->GetGenerationParams();
+    const uint32 NewMapKey = GetTypeHash(NewParams);
+    const uint32 NewSettingsHash = MapGenerator->GetSettingsHash();
+    const FIntPoint NewSize(MapGenerator->GenWidth, MapGenerator->GenHeight);
+    if (NewMapKey == MapKey && NewParams == MapParams && NewSettingsHash == MapSettingsHash
+        && NewSize == GetMapSize() && Biomes.Num() == NewSize.X * NewSize.Y)
+        return false;
+    
+    // Size the columns first; ResetExploration broadcasts and listeners may read them
+    const int32 NumHexes = FMath::Max(NewSize.X, 0) * FMath::Max(NewSize.Y, 0);
+    Biomes.SetNumUninitialized(NumHexes);
+    POIs.SetNumUninitialized(NumHexes);
+    
+    const TArray<FGW_BiomeData>& Source = MapGenerator->GetBiomeMap();
+    const bool bHasSource = Source.Num() == NumHexes;
+    for (int32 i = 0; i < NumHexes; i++)
+    {
+        Biomes[i] = bHasSource ? Source[i].BiomeEntry : EGW_HexBiome::Hill;
+        POIs[i] = bHasSource ? Source[i].POIEntry : EGW_HexPOI::None;
+    }
+    
+    Loot.Reset();
+    SavedCollectedMasks.Reset();
+    MapParams = NewParams;
+    MapSettingsHash = NewSettingsHash;
+    MapKey = NewMapKey;
+    MapSeed = NewParams.Seed;
+    ResetExploration(NewSize.X, NewSize.Y);
+    return true;
+}
+
+void UGW_HexWorldState::ResetExploration(int32 InWidth, int32 InHeight)
+{
+    Width = FMath::Max(InWidth, 0);
+    Height = FMath::Max(InHeight, 0);
+    ChunksX = FMath::DivideAndRoundUp(Width, ChunkSize);
+    ChunksY = FMath::DivideAndRoundUp(Height, ChunkSize);
+    
+    // Hidden is 0, so a zeroed store is fully unexplored
+    Bits.Reset();
+    Bits.SetNumZeroed(ChunksX * ChunksY * ChunkSize);
+    
+    // Resized without BindMap: the columns no longer describe a known map
+    if (Biomes.Num() != Width * Height)
+    {
+        Biomes.Init(EGW_HexBiome::Hill, Width * Height);
+        POIs.Init(EGW_HexPOI::None, Width * Height);
+        Loot.Reset();
+        MapParams = FGW_MapGenerationParams();
+        MapSettingsHash = 0;
+        MapKey = 0;
+    }
+    
+    // Same map: loot stays placed but nothing on it is taken any more
+    for (auto& Pair : Loot)
+    {
+        Pair.Value.CollectedMask = 0;
+    }
+    SavedCollectedMasks.Reset();
+    
+    UE_LOG(LogGrimward, Log, TEXT("HexWorldState reset for %dx%d (%d chunks, %d KB)"),
+        Width, Height, ChunksX * ChunksY, Bits.Num() * (int32)sizeof(uint64) / 1024);
+    
+    NotifyChanged(FIntRect(0, 0, Width, Height));
+}
+
+FIntRect UGW_HexWorldState::ClipRectToMap(const FIntRect& Rect) const
+{
+    const FIntPoint Min = Rect.Min.ComponentMax(FIntPoint::ZeroValue);
+    const FIntPoint Max = Rect.Max.ComponentMin(FIntPoint(Width, Height));
+    return Max.X > Min.X && Max.Y > Min.Y ? FIntRect(Min, Max) : FIntRect();
+}
+
+EGW_HexTileState UGW_HexWorldState::GetTileState(FIntPoint GridPos) const
+{
+    if (!IsValidGridPosition(GridPos))
+        return EGW_HexTileState::Hidden;
+    
+    const uint64 Word = Bits[GetWordIndex(GridPos.X, GridPos.Y)];
+    return (EGW_HexTileState)((Word >> GetBitShift(GridPos.X)) & 3);
+}
+
+FGW_HexTileData UGW_HexWorldState::GetTileData(FIntPoint GridPos) const
+{
+    FGW_HexTileData TileData;
+    TileData.GridPosition = GridPos;
+    
+    if (IsValidGridPosition(GridPos))
+    {
+        const int32 Index = GetTileIndex(GridPos);
+        TileData.BiomeType = Biomes[Index];
+        TileData.POIType = POIs[Index];
+        TileData.TileState = GetTileState(GridPos);
+        
+        const FGW_HexLoot* HexLoot = Loot.Find(Index);
+        TileData.bHasLoot = HexLoot && HexLoot->HasRemaining();
+    }
+    return TileData;
+}
+
+int32 UGW_HexWorldState::GetBiomesInRect(const FIntRect& Rect, TArrayView<EGW_HexBiome> OutBiomes) const
+{
+    const FIntRect Clipped = ClipRectToMap(Rect);
+    const int32 Count = Clipped.Area();
+    if (Count <= 0)
+        return 0;
+    
+    checkf(OutBiomes.Num() >= Count, TEXT("GetBiomesInRect: output holds %d tiles, %d needed"), OutBiomes.Num(), Count);
+    
+    const int32 RowLength = Clipped.Width();
+    int32 Out = 0;
+    for (int32 Y = Clipped.Min.Y; Y < Clipped.Max.Y; Y++, Out += RowLength)
+    {
+        FMemory::Memcpy(&OutBiomes[Out], &Biomes[Y * Width + Clipped.Min.X], RowLength * sizeof(EGW_HexBiome));
+    }
+    return Count;
+}
+
+void UGW_HexWorldState::GetBiomesForCoords(TArrayView<const FIntPoint> Coords, TArrayView<EGW_HexBiome> OutBiomes) const
+{
+    checkf(OutBiomes.Num() >= Coords.Num(), TEXT("GetBiomesForCoords: output holds %d tiles, %d needed"), OutBiomes.Num(), Coords.Num());
+    
+    for (int32 i = 0; i < Coords.Num(); i++)
+    {
+        OutBiomes[i] = GetBiome(Coords[i]);
+    }
+}
+
+void UGW_HexWorldState::GetTileDataForCoords(TArrayView<const FIntPoint> Coords, TArrayView<FGW_HexTileData> OutData) const
+{
+    checkf(OutData.Num() >= Coords.Num(), TEXT("GetTileDataForCoords: output holds %d tiles, %d needed"), OutData.Num(), Coords.Num());
+    
+    // The loot table is only probed when it has entries at all
+    const bool bAnyLoot = Loot.Num() > 0;
+    for (int32 i = 0; i < Coords.Num(); i++)
+    {
+        const FIntPoint GridPos = Coords[i];
+        FGW_HexTileData& TileData = OutData[i];
+        TileData = FGW_HexTileData();
+        TileData.GridPosition = GridPos;
+        
+        if (!IsValidGridPosition(GridPos))
+            continue;
+        
+        const int32 Index = GetTileIndex(GridPos);
+        TileData.BiomeType = Biomes[Index];
+        TileData.POIType = POIs[Index];
+        TileData.TileState = (EGW_HexTileState)((Bits[GetWordIndex(GridPos.X, GridPos.Y)] >> GetBitShift(GridPos.X)) & 3);
+        
+        if (bAnyLoot)
+        {
+            const FGW_HexLoot* HexLoot = Loot.Find(Index);
+            TileData.bHasLoot = HexLoot && HexLoot->HasRemaining();
+        }
+    }
+}
+
+int32 UGW_HexWorldState::GetTileStatesInRect(const FIntRect& Rect, TArrayView<EGW_HexTileState> OutStates) const
+{
+    const FIntPoint Min = Rect.Min.ComponentMax(FIntPoint::ZeroValue);
+    const FIntPoint Max = Rect.Max.ComponentMin(FIntPoint(Width, Height));
+    if (Max.X <= Min.X || Max.Y <= Min.Y)
+        return 0;
+    
+    const int32 Count = (Max.X - Min.X) * (Max.Y - Min.Y);
+    checkf(OutStates.Num() >= Count, TEXT("GetTileStatesInRect: output holds %d tiles, %d needed"), OutStates.Num(), Count);
+    
+    int32 Out = 0;
+    for (int32 Y = Min.Y; Y < Max.Y; Y++)
+    {
+        // Each word is read once and shifted through for its hexes
+        for (int32 X = Min.X; X < Max.X;)
+        {
+            uint64 Word = Bits[GetWordIndex(X, Y)] >> GetBitShift(X);
+            const int32 WordEnd = FMath::Min((X / ChunkSize + 1) * ChunkSize, Max.X);
+            
+            for (; X < WordEnd; X++, Word >>= BitsPerHex)
+            {
+                OutStates[Out++] = (EGW_HexTileState)(Word & 3);
+            }
+        }
+    }
+    return Count;
+}
+
+void UGW_HexWorldState::SetTileState(FIntPoint GridPos, EGW_HexTileState NewState)
+{
+    if (!IsValidGridPosition(GridPos))
+        return;
+    
+    const int32 Shift = GetBitShift(GridPos.X);
+    uint64& Word = Bits[GetWordIndex(GridPos.X, GridPos.Y)];
+    const uint64 NewWord = (Word & ~(uint64(3) << Shift)) | (uint64(NewState) << Shift);
+    
+    if (NewWord != Word)
+    {
+        Word = NewWord;
+        NotifyChanged(FIntRect(GridPos, GridPos + FIntPoint(1, 1)));
+    }
+}
+
+void UGW_HexWorldState::SetTileStates(TArrayView<const FIntPoint> Coords, EGW_HexTileState NewState)
+{
+    FIntRect DirtyRect(FIntPoint(MAX_int32, MAX_int32), FIntPoint(MIN_int32, MIN_int32));
+    bool bChanged = false;
+    
+    for (const FIntPoint& GridPos : Coords)
+    {
+        if (!IsValidGridPosition(GridPos))
+            continue;
+        
+        const int32 Shift = GetBitShift(GridPos.X);
+        uint64& Word = Bits[GetWordIndex(GridPos.X, GridPos.Y)];
+        const uint64 NewWord = (Word & ~(uint64(3) << Shift)) | (uint64(NewState) << Shift);
+        
+        if (NewWord != Word)
+        {
+            Word = NewWord;
+            DirtyRect.Include(GridPos);
+            bChanged = true;
+        }
+    }
+    
+    if (bChanged)
+    {
+        DirtyRect.Max += FIntPoint(1, 1);
+        NotifyChanged(DirtyRect);
+    }
+}
+
+void UGW_HexWorldState::Reveal(const FGW_HexRevealMask& Mask)
+{
+    if (Mask.IsEmpty())
+        return;
+    
+    // Words are written straight into the chunks, so a mask that is not clipped to this map
+    // (or was built for another one) would land in the wrong hexes or past the end of Bits
+    if (ClipRectToMap(Mask.Bounds) != Mask.Bounds || Mask.Words.Num() != Mask.WordsPerRow * Mask.Bounds.Height()
+        || Mask.WordsPerRow != (Mask.Bounds.Max.X - 1) / ChunkSize - Mask.Bounds.Min.X / ChunkSize + 1)
+    {
+        UE_LOG(LogGrimward, Warning, TEXT("Reveal: mask (%d, %d)-(%d, %d) does not fit the %dx%d map, ignored"),
+            Mask.Bounds.Min.X, Mask.Bounds.Min.Y, Mask.Bounds.Max.X, Mask.Bounds.Max.Y, Width, Height);
+        return;
+    }
+    
+    const int32 FirstChunkX = Mask.Bounds.Min.X / ChunkSize;
+    bool bChanged = false;
+    
+    for (int32 Row = 0; Row < Mask.Bounds.Height(); Row++)
+    {
+        const int32 Y = Mask.Bounds.Min.Y + Row;
+        
+        for (int32 WordX = 0; WordX < Mask.WordsPerRow; WordX++)
+        {
+            const uint64 RevealBits = Mask.Words[Row * Mask.WordsPerRow + WordX];
+            if (RevealBits == 0)
+                continue;
+            
+            // Hidden (00) becomes Explored (01); Explored and Conquered (1x) are left alone
+            uint64& Word = Bits[GetWordIndex((FirstChunkX + WordX) * ChunkSize, Y)];
+            const uint64 NewWord = Word | (RevealBits & ~Word & ~(Word >> 1));
+            
+            bChanged |= NewWord != Word;
+            Word = NewWord;
+        }
+    }
+    
+    if (bChanged)
+    {
+        NotifyChanged(Mask.Bounds);
+    }
+}
+
+void UGW_HexWorldState::RevealHexRange(FIntPoint Center, int32 Radius)
+{
+    if (Radius < 0)
+        return;
+    
+    // In odd-q offsets the range never leaves Center.Y +/- Radius
+    const FIntRect Bounds(
+        FIntPoint(Center.X - Radius, Center.Y - Radius).ComponentMax(FIntPoint::ZeroValue),
+        FIntPoint(Center.X + Radius + 1, Center.Y + Radius + 1).ComponentMin(FIntPoint(Width, Height)));
+    
+    FGW_HexRevealMask Mask;
+    Mask.Init(Bounds);
+    if (Mask.IsEmpty())
+        return;
+    
+    for (const GW_HexMath::FAxial Hex : GW_HexMath::FRange(GW_HexMath::ToAxial(Center), Radius))
+    {
+        Mask.Add(GW_HexMath::ToOffset(Hex));
+    }
+    
+    Reveal(Mask);
+}
+
+void UGW_HexWorldState::SetPOI(FIntPoint GridPos, EGW_HexPOI NewPOI)
+{
+    if (!IsValidGridPosition(GridPos) || POIs[GetTileIndex(GridPos)] == NewPOI)
+        return;
+    
+    POIs[GetTileIndex(GridPos)] = NewPOI;
+    NotifyChanged(FIntRect(GridPos, GridPos + FIntPoint(1, 1)));
+}
+
+// ========================================
+// Loot
+// ========================================
+
+void UGW_HexWorldState::SetTileLoot(FIntPoint GridPos, const TArray<FName>& Items)
+{
+    if (!IsValidGridPosition(GridPos))
+        return;
+    
+    const int32 Index = GetTileIndex(GridPos);
+    if (Items.Num() == 0)
+    {
+        if (Loot.Remove(Index) > 0)
+        {
+            NotifyChanged(FIntRect(GridPos, GridPos + FIntPoint(1, 1)));
+        }
+        return;
+    }
+    
+    if (Items.Num() > FGW_HexLoot::MaxItems)
+    {
+        UE_LOG(LogGrimward, Warning, TEXT("SetTileLoot: (%d, %d) given %d items, keeping the first %d"),
+            GridPos.X, GridPos.Y, Items.Num(), FGW_HexLoot::MaxItems);
+    }
+    
+    FGW_HexLoot& HexLoot = Loot.FindOrAdd(Index);
+    HexLoot.Items.Reset();
+    HexLoot.Items.Append(Items.GetData(), FMath::Min(Items.Num(), FGW_HexLoot::MaxItems));
+    HexLoot.CollectedMask = 0;
+    
+    uint32 SavedMask = 0;
+    if (SavedCollectedMasks.RemoveAndCopyValue(Index, SavedMask))
+    {
+        HexLoot.CollectedMask = SavedMask;
+    }
+    
+    NotifyChanged(FIntRect(GridPos, GridPos + FIntPoint(1, 1)));
+}
+
+bool UGW_HexWorldState::CollectLoot(FIntPoint GridPos, FName Item)
+{
+    FGW_HexLoot* HexLoot = IsValidGridPosition(GridPos) ? Loot.Find(GetTileIndex(GridPos)) : nullptr;
+    if (!HexLoot)
+        return false;
+    
+    for (int32 i = 0; i < HexLoot->Items.Num(); i++)
+    {
+        if (HexLoot->Items[i] == Item && !HexLoot->IsCollected(i))
+        {
+            HexLoot->CollectedMask |= 1u << i;
+            NotifyChanged(FIntRect(GridPos, GridPos + FIntPoint(1, 1)));
+            return true;
+        }
+    }
+    return false;
+}
+
+int32 UGW_HexWorldState::GetAvailableLoot(FIntPoint GridPos, TArray<FName>& OutItems) const
+{
+    OutItems.Reset();
+    if (const FGW_HexLoot* HexLoot = FindLoot(GridPos))
+    {
+        for (int32 i = 0; i < HexLoot->Items.Num(); i++)
+        {
+            if (!HexLoot->IsCollected(i))
+            {
+                OutItems.Add(HexLoot->Items[i]);
+            }
+        }
+    }
+    return OutItems.Num();
+}
+
+int32 UGW_HexWorldState::GetCollectedLoot(FIntPoint GridPos, TArray<FName>& OutItems) const
+{
+    OutItems.Reset();
+    if (const FGW_HexLoot* HexLoot = FindLoot(GridPos))
+    {
+        for (int32 i = 0; i < HexLoot->Items.Num(); i++)
+        {
+            if (HexLoot->IsCollected(i))
+            {
+                OutItems.Add(HexLoot->Items[i]);
+            }
+        }
+    }
+    return OutItems.Num();
+}
+
+// ========================================
+// Save
+// ========================================
+
+void UGW_HexWorldState::ExportExploration(FGW_ExplorationSaveData& OutData) const
+{
+    using namespace GW_ExplorationSave;
+    
+    OutData = FGW_ExplorationSaveData();
+    OutData.Version = FGW_ExplorationSaveData::CurrentVersion;
+    OutData.Params = MapParams;
+    OutData.GeneratorSettingsHash = MapSettingsHash;
+    OutData.Width = Width;
+    OutData.Height = Height;
+    
+    // Most rows are one or two long runs; noisy ones fall back to 2 bits per hex
+    const int32 PackedRowBytes = FMath::DivideAndRoundUp(Width, 4);
+    TArray<EGW_HexTileState> RowStates;
+    TArray<uint8> RowRuns;
+    RowStates.SetNumUninitialized(Width);
+    
+    for (int32 Y = 0; Y < Height; Y++)
+    {
+        GetTileStatesInRect(FIntRect(0, Y, Width, Y + 1), RowStates);
+        
+        RowRuns.Reset();
+        for (int32 X = 0; X < Width && RowRuns.Num() < PackedRowBytes;)
+        {
+            const EGW_HexTileState State = RowStates[X];
+            int32 RunEnd = X + 1;
+            while (RunEnd < Width && RowStates[RunEnd] == State)
+            {
+                RunEnd++;
+            }
+            WriteVarInt(RowRuns, uint32(RunEnd - X) << 2 | uint32(State));
+            X = RunEnd;
+        }
+        
+        if (RowRuns.Num() < PackedRowBytes)
+        {
+            OutData.TileStates.Add((uint8)ERowMode::Runs);
+            OutData.TileStates.Append(RowRuns);
+        }
+        else
+        {
+            OutData.TileStates.Add((uint8)ERowMode::Packed);
+            const int32 RowStart = OutData.TileStates.AddZeroed(PackedRowBytes);
+            for (int32 X = 0; X < Width; X++)
+            {
+                OutData.TileStates[RowStart + X / 4] |= uint8(RowStates[X]) << ((X % 4) * BitsPerHex);
+            }
+        }
+    }
+    
+    // Loot placement is not saved, only what was taken
+    for (const auto& Pair : Loot)
+    {
+        if (Pair.Value.CollectedMask != 0)
+        {
+            OutData.LootTileIndices.Add(Pair.Key);
+            OutData.LootCollectedMasks.Add(Pair.Value.CollectedMask);
+        }
+    }
+    
+    UE_LOG(LogGrimward, Log, TEXT("HexWorldState: exported %dx%d exploration in %d KB, %d looted hexes"),
+        Width, Height, OutData.TileStates.Num() / 1024, OutData.LootTileIndices.Num());
+}
+
+bool UGW_HexWorldState::ImportExploration(const FGW_ExplorationSaveData& Data)
+{
+    using namespace GW_ExplorationSave;
+    
+    if (Data.Version != FGW_ExplorationSaveData::CurrentVersion || !Data.HasMap())
+    {
+        UE_LOG(LogGrimward, Warning, TEXT("ImportExploration: unsupported save (version %d)"), Data.Version);
+        return false;
+    }
+    
+    if (MapKey == 0 || Data.Params != MapParams || Data.GeneratorSettingsHash != MapSettingsHash
+        || Data.Width != Width || Data.Height != Height)
+    {
+        UE_LOG(LogGrimward, Warning, TEXT("ImportExploration: save is for another map (seed %d, %dx%d)"), Data.Params.Seed, Data.Width, Data.Height);
+        return false;
+    }
+    
+    // Decode into a fresh store so a truncated save changes nothing
+    TArray<uint64> NewBits;
+    NewBits.SetNumZeroed(Bits.Num());
+    
+    const TArrayView<const uint8> In = Data.TileStates;
+    const int32 PackedRowBytes = FMath::DivideAndRoundUp(Width, 4);
+    int32 Offset = 0;
+    
+    auto SetState = [this, &NewBits](int32 X, int32 Y, uint32 State)
+    {
+        NewBits[GetWordIndex(X, Y)] |= uint64(State) << GetBitShift(X);
+    };
+    
+    for (int32 Y = 0; Y < Height; Y++)
+    {
+        if (Offset >= In.Num())
+            return false;
+        
+        const uint8 ModeByte = In[Offset++];
+        if (ModeByte > (uint8)ERowMode::Packed)
+            return false;
+        
+        const ERowMode Mode = (ERowMode)ModeByte;
+        if (Mode == ERowMode::Packed)
+        {
+            if (Offset + PackedRowBytes > In.Num())
+                return false;
+            
+            for (int32 X = 0; X < Width; X++)
+            {
+                // 3 is not a tile state; a save holding it is corrupt, not something to round down
+                const uint32 State = (In[Offset + X / 4] >> ((X % 4) * BitsPerHex)) & 3u;
+                if (State > (uint32)EGW_HexTileState::Conquered)
+                    return false;
+                
+                SetState(X, Y, State);
+            }
+            Offset += PackedRowBytes;
+            continue;
+        }
+        
+        for (int32 X = 0; X < Width;)
+        {
+            uint32 Run = 0;
+            if (!ReadVarInt(In, Offset, Run) || (Run >> 2) == 0 || X + int32(Run >> 2) > Width
+                || (Run & 3u) > (uint32)EGW_HexTileState::Conquered)
+                return false;
+            
+            // Hidden is already zero
+            const int32 RunEnd = X + int32(Run >> 2);
+            if ((Run & 3u) != 0)
+            {
+                for (; X < RunEnd; X++)
+                {
+                    SetState(X, Y, Run & 3u);
+                }
+            }
+            X = RunEnd;
+        }
+    }
+    
+    // Anything after the last row means the data is not what this decoder wrote
+    if (Offset != In.Num())
+        return false;
+    
+    if (Data.LootTileIndices.Num() != Data.LootCollectedMasks.Num())
+        return false;
+    
+    for (const int32 TileIndex : Data.LootTileIndices)
+    {
+        if (TileIndex < 0 || TileIndex >= Width * Height)
+            return false;
+    }
+    
+    Bits = MoveTemp(NewBits);
+    
+    // Loot that is already placed takes its mask now, the rest when SetTileLoot places it
+    SavedCollectedMasks.Reset();
+    for (auto& Pair : Loot)
+    {
+        Pair.Value.CollectedMask = 0;
+    }
+    
+    for (int32 i = 0; i < Data.LootTileIndices.Num(); i++)
+    {
+        if (FGW_HexLoot* HexLoot = Loot.Find(Data.LootTileIndices[i]))
+        {
+            HexLoot->CollectedMask = Data.LootCollectedMasks[i];
+        }
+        else
+        {
+            SavedCollectedMasks.Add(Data.LootTileIndices[i], Data.LootCollectedMasks[i]);
+        }
+    }
+    
+    NotifyChanged(FIntRect(0, 0, Width, Height));
+    return true;
+}
+
+void UGW_HexWorldState::NotifyChanged(const FIntRect& DirtyRect)
+{
+    Revision++;
+    ExplorationChangedEvent.Broadcast(DirtyRect);
+}
+#pragma endregion
+/*-------------------------------------------------------------------------*/
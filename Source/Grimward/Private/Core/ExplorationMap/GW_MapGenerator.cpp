@@ -3,10 +3,96 @@
 #include "Core/ExplorationMap/GW_MapGenerator.h"
 #include "Engine/Texture2D.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
 /*-------------------------------------------------------------------------*/
 
 
 
+/*-------------------------------------------------------------------------*/
+/*  Helpers                                                                */
+/*-------------------------------------------------------------------------*/
+namespace
+{
+    /** Open-set entry for the priority flood. Ties break on index so the fill is deterministic. */
+    struct FFloodNode
+    {
+        float Elevation;
+        int32 Index;
+        
+        bool operator<(const FFloodNode& Other) const
+        {
+            return Elevation < Other.Elevation || (Elevation == Other.Elevation && Index < Other.Index);
+        }
+    };
+    
+    /**
+     * Uniform acceleration grid for Poisson-disk sampling. The bucket size is
+     * MinSpacing / sqrt(2), so every bucket can hold at most one accepted sample.
+     */
+    struct FPOISpatialGrid
+    {
+        float CellSize = 1.0f;
+        int32 NumX = 0;
+        int32 NumY = 0;
+        TArray<FVector2f> Positions;
+        TArray<float> Radii;            // 0 marks an empty bucket
+        
+        void Init(float InCellSize, const FVector2f& Extent)
+        {
+            CellSize = InCellSize;
+            NumX = FMath::Max(1, FMath::CeilToInt(Extent.X / CellSize) + 1);
+            NumY = FMath::Max(1, FMath::CeilToInt(Extent.Y / CellSize) + 1);
+            Positions.SetNumUninitialized(NumX * NumY);
+            Radii.SetNumZeroed(NumX * NumY);
+        }
+        
+        FIntPoint ToBucket(const FVector2f& P) const
+        {
+            return FIntPoint(
+                FMath::Clamp(FMath::FloorToInt(P.X / CellSize), 0, NumX - 1),
+                FMath::Clamp(FMath::FloorToInt(P.Y / CellSize), 0, NumY - 1));
+        }
+        
+        bool IsFree(const FVector2f& P, float Radius, int32 SearchRange) const
+        {
+            const FIntPoint B = ToBucket(P);
+            const int32 MinX = FMath::Max(0, B.X - SearchRange);
+            const int32 MaxX = FMath::Min(NumX - 1, B.X + SearchRange);
+            const int32 MinY = FMath::Max(0, B.Y - SearchRange);
+            const int32 MaxY = FMath::Min(NumY - 1, B.Y + SearchRange);
+            
+            for (int32 BY = MinY; BY <= MaxY; BY++)
+            {
+                for (int32 BX = MinX; BX <= MaxX; BX++)
+                {
+                    const int32 Index = BY * NumX + BX;
+                    if (Radii[Index] > 0.0f)
+                    {
+                        const float MinDist = FMath::Max(Radius, Radii[Index]);
+                        if (FVector2f::DistSquared(P, Positions[Index]) < MinDist * MinDist)
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+        
+        void Insert(const FVector2f& P, float Radius)
+        {
+            const FIntPoint B = ToBucket(P);
+            const int32 Index = B.Y * NumX + B.X;
+            Positions[Index] = P;
+            Radii[Index] = Radius;
+        }
+    };
+}
+
+
+
 /*-------------------------------------------------------------------------*/
 /*  Functions                                                              */
 /*-------------------------------------------------------------------------*/
@@ -91,6 +177,63 @@ void AGW_MapGenerator::InitializeBiomeData()
     FGW_BiomeGenerationInfo LavascapeData;
     LavascapeData.HexBiomeWeights.Add(EGW_HexBiome::Lavascape, 1.0f);
     BiomeDataConfig.Add(TEXT("lavascape"), LavascapeData);
+    
+    // POI weights per category (water has none, so nothing spawns on it)
+    BiomeDataConfig[TEXT("hills")].HexPOIWeights = {
+        { EGW_HexPOI::Village, 0.3f }, { EGW_HexPOI::MarauderCamp, 0.25f }, { EGW_HexPOI::Ruin, 0.2f },
+        { EGW_HexPOI::Monster, 0.15f }, { EGW_HexPOI::Tomb, 0.1f } };
+    BiomeDataConfig[TEXT("forest")].HexPOIWeights = {
+        { EGW_HexPOI::Monster, 0.3f }, { EGW_HexPOI::Village, 0.2f }, { EGW_HexPOI::MarauderCamp, 0.2f },
+        { EGW_HexPOI::Ruin, 0.2f }, { EGW_HexPOI::WizardTower, 0.1f } };
+    BiomeDataConfig[TEXT("mountain")].HexPOIWeights = {
+        { EGW_HexPOI::Forge, 0.25f }, { EGW_HexPOI::Monster, 0.25f }, { EGW_HexPOI::Labyrinth, 0.2f },
+        { EGW_HexPOI::Crypt, 0.15f }, { EGW_HexPOI::DragonPerch, 0.15f } };
+    BiomeDataConfig[TEXT("great_peak")].HexPOIWeights = {
+        { EGW_HexPOI::DragonPerch, 0.5f }, { EGW_HexPOI::Monolith, 0.3f }, { EGW_HexPOI::Temple, 0.2f } };
+    BiomeDataConfig[TEXT("desert")].HexPOIWeights = {
+        { EGW_HexPOI::Oasis, 0.35f }, { EGW_HexPOI::Tomb, 0.3f }, { EGW_HexPOI::Ruin, 0.2f },
+        { EGW_HexPOI::Monolith, 0.15f } };
+    BiomeDataConfig[TEXT("swamp")].HexPOIWeights = {
+        { EGW_HexPOI::Monster, 0.4f }, { EGW_HexPOI::Crypt, 0.3f }, { EGW_HexPOI::Ruin, 0.3f } };
+    BiomeDataConfig[TEXT("ice_spike")].HexPOIWeights = {
+        { EGW_HexPOI::CrystalField, 0.4f }, { EGW_HexPOI::Monster, 0.3f }, { EGW_HexPOI::Temple, 0.3f } };
+    BiomeDataConfig[TEXT("mystic_forest")].HexPOIWeights = {
+        { EGW_HexPOI::WizardTower, 0.35f }, { EGW_HexPOI::Rift, 0.25f }, { EGW_HexPOI::Monolith, 0.2f },
+        { EGW_HexPOI::Temple, 0.2f } };
+    BiomeDataConfig[TEXT("poisonous_swamp")].HexPOIWeights = {
+        { EGW_HexPOI::Crypt, 0.4f }, { EGW_HexPOI::Rift, 0.3f }, { EGW_HexPOI::Monster, 0.3f } };
+    BiomeDataConfig[TEXT("dragon_boneyard")].HexPOIWeights = {
+        { EGW_HexPOI::DragonPerch, 0.4f }, { EGW_HexPOI::Tomb, 0.3f }, { EGW_HexPOI::Crypt, 0.3f } };
+    BiomeDataConfig[TEXT("lavascape")].HexPOIWeights = {
+        { EGW_HexPOI::Forge, 0.4f }, { EGW_HexPOI::Rift, 0.35f }, { EGW_HexPOI::Monster, 0.25f } };
+    
+    BuildPOIAliasTables();
+}
+
+void AGW_MapGenerator::BuildPOIAliasTables()
+{
+    // A biome can be rolled from several categories, so its POI weights are the
+    // category POI weights scaled by how likely that category is to produce the biome.
+    TMap<EGW_HexBiome, TMap<EGW_HexPOI, float>> WeightsPerBiome;
+    
+    for (const auto& CategoryPair : BiomeDataConfig)
+    {
+        const FGW_BiomeGenerationInfo& Info = CategoryPair.Value;
+        for (const auto& BiomePair : Info.HexBiomeWeights)
+        {
+            TMap<EGW_HexPOI, float>& Weights = WeightsPerBiome.FindOrAdd(BiomePair.Key);
+            for (const auto& POIPair : Info.HexPOIWeights)
+            {
+                Weights.FindOrAdd(POIPair.Key) += POIPair.Value * BiomePair.Value;
+            }
+        }
+    }
+    
+    POIAliasTables.Empty();
+    for (const auto& Pair : WeightsPerBiome)
+    {
+        POIAliasTables.Add(Pair.Key).Build(Pair.Value);
+    }
 }
 
 void AGW_MapGenerator::GenerateBiomeMap(int32 InSeed)
@@ -106,6 +249,7 @@ void AGW_MapGenerator::GenerateBiomeMap(int32 InSeed)
     VolatilityMap.Empty();
     EnchantmentMap.Empty();
     BiomeMap.Empty();
+    BiomeTypeMap.Empty();
     
     // Generate all noise maps
     TemperatureMap = GenerateNoiseMap(TemperaturePeriod, TemperatureOctaves, Seed);
@@ -117,28 +261,51 @@ void AGW_MapGenerator::GenerateBiomeMap(int32 InSeed)
     // Determine biomes for each position
     DetermmineBiomes();
     
+    // Carve rivers before POIs so nothing spawns in them
+    if (bGenerateRivers)
+    {
+        GenerateHydrology();
+    }
+    
+    // Scatter POIs over the biomes
+    POILocations.Empty();
+    if (bGeneratePOIs)
+    {
+        PlacePOIs();
+    }
+    
+    // Pack the final biomes for the biome-only query path
+    BiomeTypeMap.SetNumUninitialized(BiomeMap.Num());
+    for (int32 Index = 0; Index < BiomeMap.Num(); Index++)
+    {
+        BiomeTypeMap[Index] = BiomeMap[Index].BiomeEntry;
+    }
+    
     UE_LOG(LogTemp, Log, TEXT("Biome map generated with seed: %d, Size: %dx%d"), Seed, GenWidth, GenHeight);
 }
 
-TMap<FIntPoint, float> AGW_MapGenerator::GenerateNoiseMap(float Period, int32 Octaves, int32 NoiseSeed)
+TArray<float> AGW_MapGenerator::GenerateNoiseMap(float Period, int32 Octaves, int32 NoiseSeed)
 {
-    TMap<FIntPoint, float> NoiseMap;
+    TArray<float> NoiseMap;
+    NoiseMap.SetNumUninitialized(GenWidth * GenHeight);
     
-    for (int32 X = 0; X < GenWidth; X++)
+    // Sample at hex centres so biome shapes are not skewed by the odd-q column shift
+    ParallelFor(GenHeight, [&](int32 Y)
     {
-        for (int32 Y = 0; Y < GenHeight; Y++)
+        for (int32 X = 0; X < GenWidth; X++)
         {
-            float NoiseValue = GetPerlinNoise2D(X, Y, Period, Octaves, NoiseSeed);
+            const FVector2f SamplePos = GetHexSamplePosition(X, Y);
+            float NoiseValue = GetPerlinNoise2D(SamplePos.X, SamplePos.Y, Period, Octaves, NoiseSeed);
             // Convert to 0-2 range and take absolute value
             NoiseValue = 2.0f * FMath::Abs(NoiseValue);
-            NoiseMap.Add(FIntPoint(X, Y), NoiseValue);
+            NoiseMap[GetTileIndex(X, Y)] = NoiseValue;
         }
-    }
+    });
     
     return NoiseMap;
 }
 
-float AGW_MapGenerator::GetPerlinNoise2D(float X, float Y, float Period, int32 Octaves, int32 NoiseSeed)
+float AGW_MapGenerator::GetPerlinNoise2D(float X, float Y, float Period, int32 Octaves, int32 NoiseSeed) const
 {
     float Total = 0.0f;
     float Frequency = 1.0f / Period;
@@ -166,17 +333,19 @@ float AGW_MapGenerator::GetPerlinNoise2D(float X, float Y, float Period, int32 O
 
 void AGW_MapGenerator::DetermmineBiomes()
 {
-    for (int32 X = 0; X < GenWidth; X++)
+    BiomeMap.SetNum(GenWidth * GenHeight);
+    
+    for (int32 Y = 0; Y < GenHeight; Y++)
     {
-        for (int32 Y = 0; Y < GenHeight; Y++)
+        for (int32 X = 0; X < GenWidth; X++)
         {
-            FIntPoint Pos(X, Y);
+            const int32 Index = GetTileIndex(X, Y);
             
-            float Alt = AltitudeMap[Pos];
-            float Temp = TemperatureMap[Pos];
-            float Moist = MoistureMap[Pos];
-            float Volat = VolatilityMap[Pos];
-            float Ench = EnchantmentMap[Pos];
+            float Alt = AltitudeMap[Index];
+            float Temp = TemperatureMap[Index];
+            float Moist = MoistureMap[Index];
+            float Volat = VolatilityMap[Index];
+            float Ench = EnchantmentMap[Index];
             
             FGW_BiomeData BiomeData;
             BiomeData.Altitude = Alt;
@@ -189,7 +358,7 @@ void AGW_MapGenerator::DetermmineBiomes()
             FString Category;
             BiomeData.BiomeEntry = DetermineBiomeCategory(Alt, Temp, Moist, Ench, Category);
             
-            BiomeMap.Add(Pos, BiomeData);
+            BiomeMap[Index] = BiomeData;
         }
     }
 }
@@ -372,6 +541,292 @@ EGW_HexBiome AGW_MapGenerator::GetRandomTileForCategory(const FString& Category)
     return EGW_HexBiome::Hill;
 }
 
+void AGW_MapGenerator::GenerateHydrology()
+{
+    // Priority-Flood+Queue (Barnes et al. 2014). Flooding starts from the map border and
+    // existing water, and every tile drains into the tile that first reached it. That gives
+    // a depression-free drainage tree without a separate flow-direction pass, and the pop
+    // order is a topological order of that tree.
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 NumTiles = GenWidth * GenHeight;
+    if (NumTiles == 0)
+    {
+        return;
+    }
+    
+    TArray<float> Filled = AltitudeMap;
+    TArray<float> Accumulation = MoistureMap;
+    TArray<uint8> IsWater;
+    IsWater.SetNumUninitialized(NumTiles);
+    for (int32 Index = 0; Index < NumTiles; Index++)
+    {
+        IsWater[Index] = BiomeMap[Index].BiomeEntry == EGW_HexBiome::Water;
+    }
+    
+    TArray<int32> Receiver;
+    TArray<int32> Basin;
+    TArray<uint8> Closed;
+    TArray<int32> Order;
+    Receiver.Init(INDEX_NONE, NumTiles);
+    Basin.SetNumUninitialized(NumTiles);
+    Closed.SetNumZeroed(NumTiles);
+    Order.Reserve(NumTiles);
+    
+    TArray<FFloodNode> Open;
+    TArray<int32> Pits;
+    int32 PitHead = 0;
+    int32 NumBasins = 0;
+    
+    // Seed outlets: the map border drains off-map, water tiles drain into themselves
+    for (int32 Y = 0; Y < GenHeight; Y++)
+    {
+        for (int32 X = 0; X < GenWidth; X++)
+        {
+            const int32 Index = Y * GenWidth + X;
+            const bool bBorder = X == 0 || Y == 0 || X == GenWidth - 1 || Y == GenHeight - 1;
+            if (bBorder || IsWater[Index])
+            {
+                Closed[Index] = 1;
+                Basin[Index] = NumBasins++;
+                Open.Add({ Filled[Index], Index });
+            }
+        }
+    }
+    Open.Heapify();
+    
+    while (Open.Num() > 0 || PitHead < Pits.Num())
+    {
+        int32 Current;
+        if (PitHead < Pits.Num())
+        {
+            Current = Pits[PitHead++];
+        }
+        else
+        {
+            FFloodNode Node;
+            Open.HeapPop(Node, EAllowShrinking::No);
+            Current = Node.Index;
+        }
+        Order.Add(Current);
+        
+        const int32 CX = Current % GenWidth;
+        const int32 CY = Current / GenWidth;
+        const int32 Parity = CX & 1;
+        for (int32 Dir = 0; Dir < 6; Dir++)
+        {
+            const int32 NX = CX + GW_HexMath::OffsetNeighborDX[Parity][Dir];
+            const int32 NY = CY + GW_HexMath::OffsetNeighborDY[Parity][Dir];
+            if (NX < 0 || NY < 0 || NX >= GenWidth || NY >= GenHeight)
+            {
+                continue;
+            }
+            
+            const int32 Neighbor = NY * GenWidth + NX;
+            if (Closed[Neighbor])
+            {
+                continue;
+            }
+            
+            Closed[Neighbor] = 1;
+            Receiver[Neighbor] = Current;
+            Basin[Neighbor] = Basin[Current];
+            
+            if (Filled[Neighbor] <= Filled[Current])
+            {
+                // Inside a depression: raise to the spill height and flood it in FIFO order
+                Filled[Neighbor] = Filled[Current];
+                Pits.Add(Neighbor);
+            }
+            else
+            {
+                Open.HeapPush({ Filled[Neighbor], Neighbor });
+            }
+        }
+        
+        // Keep the pit queue from growing with the whole map
+        if (PitHead == Pits.Num())
+        {
+            Pits.Reset();
+            PitHead = 0;
+        }
+    }
+    
+    // Bucket the flood order by drainage basin (stable counting sort). Basins never exchange
+    // water, so each one can be accumulated on its own thread.
+    TArray<int32> BasinStart;
+    BasinStart.SetNumZeroed(NumBasins + 1);
+    for (int32 Index : Order)
+    {
+        BasinStart[Basin[Index] + 1]++;
+    }
+    for (int32 i = 0; i < NumBasins; i++)
+    {
+        BasinStart[i + 1] += BasinStart[i];
+    }
+    
+    TArray<int32> SortedOrder;
+    SortedOrder.SetNumUninitialized(Order.Num());
+    {
+        TArray<int32> Cursor = BasinStart;
+        for (int32 Index : Order)
+        {
+            SortedOrder[Cursor[Basin[Index]]++] = Index;
+        }
+    }
+    
+    // Most basins are a single border or water tile, so group them into chunks of work
+    TArray<int32> ChunkStartBasin;
+    const int32 TargetChunkTiles = FMath::Max(4096, NumTiles / 256);
+    for (int32 B = 0, ChunkTiles = TargetChunkTiles; B < NumBasins; B++)
+    {
+        if (ChunkTiles >= TargetChunkTiles)
+        {
+            ChunkStartBasin.Add(B);
+            ChunkTiles = 0;
+        }
+        ChunkTiles += BasinStart[B + 1] - BasinStart[B];
+    }
+    ChunkStartBasin.Add(NumBasins);
+    
+    ParallelFor(ChunkStartBasin.Num() - 1, [&](int32 Chunk)
+    {
+        const int32 First = BasinStart[ChunkStartBasin[Chunk]];
+        const int32 Last = BasinStart[ChunkStartBasin[Chunk + 1]];
+        
+        // Reverse flood order visits every tile after all of its upstream tiles
+        for (int32 i = Last - 1; i >= First; i--)
+        {
+            const int32 Index = SortedOrder[i];
+            if (Receiver[Index] != INDEX_NONE)
+            {
+                Accumulation[Receiver[Index]] += Accumulation[Index];
+            }
+        }
+    });
+    
+    // Carve rivers
+    int32 RiverTiles = 0;
+    for (int32 Index = 0; Index < NumTiles; Index++)
+    {
+        if (!IsWater[Index] && Accumulation[Index] >= RiverAccumulationThreshold)
+        {
+            BiomeMap[Index].BiomeEntry = EGW_HexBiome::River;
+            RiverTiles++;
+        }
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Hydrology: %d river tiles, %d basins, %.1f ms"),
+        RiverTiles, NumBasins, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void AGW_MapGenerator::PlacePOIs()
+{
+    // Variable-radius Poisson-disk sampling: the spacing shrinks as Volatility grows.
+    // The map is split into tiles that are processed in four phases (by tile parity), so
+    // tiles running in parallel are always a full tile apart and never touch the same
+    // buckets. Each tile uses its own seeded stream, which keeps the result independent
+    // of thread scheduling.
+    const float MinSpacing = FMath::Max(1.0f, POIMinSpacing);
+    const float MaxSpacing = FMath::Max(MinSpacing, POIMaxSpacing);
+    
+    FPOISpatialGrid Grid;
+    Grid.Init(MinSpacing / UE_SQRT_2, FVector2f(GenWidth, (GenHeight + 1) * HexRowSpacing));
+    
+    const int32 SearchRange = FMath::CeilToInt(MaxSpacing / Grid.CellSize);
+    const int32 TileBuckets = FMath::Max(SearchRange + 1, FMath::CeilToInt(POITileSize / Grid.CellSize));
+    const int32 TilesX = FMath::DivideAndRoundUp(Grid.NumX, TileBuckets);
+    const int32 TilesY = FMath::DivideAndRoundUp(Grid.NumY, TileBuckets);
+    
+    struct FTileResult
+    {
+        TArray<FIntPoint> Positions;
+        TArray<EGW_HexPOI> Types;
+    };
+    TArray<FTileResult> TileResults;
+    TileResults.SetNum(TilesX * TilesY);
+    
+    for (int32 Phase = 0; Phase < 4; Phase++)
+    {
+        TArray<int32> PhaseTiles;
+        for (int32 TY = Phase / 2; TY < TilesY; TY += 2)
+        {
+            for (int32 TX = Phase % 2; TX < TilesX; TX += 2)
+            {
+                PhaseTiles.Add(TY * TilesX + TX);
+            }
+        }
+        
+        ParallelFor(PhaseTiles.Num(), [&](int32 PhaseIndex)
+        {
+            const int32 TileIndex = PhaseTiles[PhaseIndex];
+            const FIntPoint Tile(TileIndex % TilesX, TileIndex / TilesX);
+            const FIntPoint BucketMin = Tile * TileBuckets;
+            const FIntPoint BucketMax = BucketMin + FIntPoint(TileBuckets, TileBuckets);
+            FRandomStream TileStream(HashCombine(GetTypeHash(Seed), GetTypeHash(Tile)));
+            
+            // Candidate cells whose sample position falls into this tile's buckets
+            // (bucket Y is in sample space, where rows are HexRowSpacing apart)
+            TArray<FIntPoint> Candidates;
+            const int32 MinX = FMath::Max(0, FMath::FloorToInt(BucketMin.X * Grid.CellSize) - 1);
+            const int32 MaxX = FMath::Min(GenWidth - 1, FMath::CeilToInt(BucketMax.X * Grid.CellSize) + 1);
+            const int32 MinY = FMath::Max(0, FMath::FloorToInt(BucketMin.Y * Grid.CellSize / HexRowSpacing) - 1);
+            const int32 MaxY = FMath::Min(GenHeight - 1, FMath::CeilToInt(BucketMax.Y * Grid.CellSize / HexRowSpacing) + 1);
+            for (int32 Y = MinY; Y <= MaxY; Y++)
+            {
+                for (int32 X = MinX; X <= MaxX; X++)
+                {
+                    const FIntPoint B = Grid.ToBucket(GetHexSamplePosition(X, Y));
+                    if (B.X >= BucketMin.X && B.X < BucketMax.X && B.Y >= BucketMin.Y && B.Y < BucketMax.Y)
+                    {
+                        Candidates.Add(FIntPoint(X, Y));
+                    }
+                }
+            }
+            
+            // Shuffle so the acceptance order has no directional bias
+            for (int32 i = Candidates.Num() - 1; i > 0; i--)
+            {
+                Candidates.Swap(i, TileStream.RandRange(0, i));
+            }
+            
+            FTileResult& Result = TileResults[TileIndex];
+            for (const FIntPoint& Pos : Candidates)
+            {
+                const FGW_BiomeData& BiomeData = BiomeMap[GetTileIndex(Pos.X, Pos.Y)];
+                const FGW_POIAliasTable* Table = POIAliasTables.Find(BiomeData.BiomeEntry);
+                if (!Table || Table->IsEmpty())
+                {
+                    continue;
+                }
+                
+                const float Density = FMath::Clamp(BiomeData.Volatility * 0.5f, 0.0f, 1.0f);
+                const float Radius = FMath::Lerp(MaxSpacing, MinSpacing, Density);
+                const FVector2f SamplePos = GetHexSamplePosition(Pos.X, Pos.Y);
+                
+                if (Grid.IsFree(SamplePos, Radius, SearchRange))
+                {
+                    Grid.Insert(SamplePos, Radius);
+                    Result.Positions.Add(Pos);
+                    Result.Types.Add(Table->Sample(TileStream));
+                }
+            }
+        });
+    }
+    
+    // Merge in tile order so the output is identical on every run
+    for (const FTileResult& Result : TileResults)
+    {
+        for (int32 i = 0; i < Result.Positions.Num(); i++)
+        {
+            const FIntPoint& Pos = Result.Positions[i];
+            BiomeMap[GetTileIndex(Pos.X, Pos.Y)].POIEntry = Result.Types[i];
+            POILocations.Add(Result.Positions[i]);
+        }
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("Placed %d POIs (%d sampling tiles)"), POILocations.Num(), TilesX * TilesY);
+}
+
 bool AGW_MapGenerator::IsBetween(float Value, float Start, float End) const
 {
     return Value >= Start && Value < End;
@@ -379,65 +834,299 @@ bool AGW_MapGenerator::IsBetween(float Value, float Start, float End) const
 
 FGW_BiomeData AGW_MapGenerator::GetBiomeDataAt(int32 X, int32 Y) const
 {
-    FIntPoint Pos(X, Y);
-    if (BiomeMap.Contains(Pos))
+    if (const FGW_BiomeData* BiomeData = FindBiomeDataAt(FIntPoint(X, Y)))
     {
-        return BiomeMap[Pos];
+        return *BiomeData;
     }
     
     return FGW_BiomeData();
 }
 
-UTexture2D* AGW_MapGenerator::GenerateTestDebugTexture()
+FIntRect AGW_MapGenerator::ClipRectToMap(const FIntRect& Rect) const
 {
     if (BiomeMap.Num() == 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("BiomeMap is empty. Generate biome map first."));
-        return nullptr;
+        return FIntRect();
+    }
+    
+    FIntRect Clipped(
+        FIntPoint(FMath::Max(Rect.Min.X, 0), FMath::Max(Rect.Min.Y, 0)),
+        FIntPoint(FMath::Min(Rect.Max.X, GenWidth), FMath::Min(Rect.Max.Y, GenHeight)));
+    Clipped.Max = Clipped.Max.ComponentMax(Clipped.Min);
+    return Clipped;
+}
+
+int32 AGW_MapGenerator::GetBiomeDataInRect(const FIntRect& Rect, TArrayView<FGW_BiomeData> OutData) const
+{
+    const FIntRect Clipped = ClipRectToMap(Rect);
+    const int32 RowLength = Clipped.Width();
+    const int32 Count = RowLength * Clipped.Height();
+    checkf(OutData.Num() >= Count, TEXT("GetBiomeDataInRect: output holds %d tiles, %d needed"), OutData.Num(), Count);
+    if (Count == 0)
+    {
+        return 0;
+    }
+    
+    // Rows are contiguous in storage, so each one is a single copy
+    for (int32 Y = Clipped.Min.Y, Out = 0; Y < Clipped.Max.Y; Y++, Out += RowLength)
+    {
+        FMemory::Memcpy(&OutData[Out], &BiomeMap[GetTileIndex(Clipped.Min.X, Y)], RowLength * sizeof(FGW_BiomeData));
+    }
+    return Count;
+}
+
+int32 AGW_MapGenerator::GetBiomesInRect(const FIntRect& Rect, TArrayView<EGW_HexBiome> OutBiomes) const
+{
+    const FIntRect Clipped = ClipRectToMap(Rect);
+    const int32 RowLength = Clipped.Width();
+    const int32 Count = RowLength * Clipped.Height();
+    checkf(OutBiomes.Num() >= Count, TEXT("GetBiomesInRect: output holds %d tiles, %d needed"), OutBiomes.Num(), Count);
+    if (Count == 0)
+    {
+        return 0;
+    }
+    
+    for (int32 Y = Clipped.Min.Y, Out = 0; Y < Clipped.Max.Y; Y++, Out += RowLength)
+    {
+        FMemory::Memcpy(&OutBiomes[Out], &BiomeTypeMap[GetTileIndex(Clipped.Min.X, Y)], RowLength * sizeof(EGW_HexBiome));
+    }
+    return Count;
+}
+
+int32 AGW_MapGenerator::GetBiomeDataInHexRange(FIntPoint Center, int32 Radius, TArrayView<FGW_BiomeData> OutData, TArrayView<FIntPoint> OutCoords) const
+{
+    const int32 MaxCount = GetHexRangeCount(Radius);
+    checkf(OutData.Num() >= MaxCount, TEXT("GetBiomeDataInHexRange: output holds %d tiles, %d needed"), OutData.Num(), MaxCount);
+    checkf(OutCoords.Num() == 0 || OutCoords.Num() >= MaxCount, TEXT("GetBiomeDataInHexRange: coordinate output too small"));
+    
+    int32 Count = 0;
+    for (const GW_HexMath::FAxial Hex : GW_HexMath::FRange(GW_HexMath::ToAxial(Center), Radius))
+    {
+        const FIntPoint GridPos = GW_HexMath::ToOffset(Hex);
+        if (!IsValidGridPosition(GridPos))
+        {
+            continue;
+        }
+        
+        OutData[Count] = BiomeMap[GetTileIndex(GridPos.X, GridPos.Y)];
+        if (OutCoords.Num() > 0)
+        {
+            OutCoords[Count] = GridPos;
+        }
+        Count++;
     }
+    return Count;
+}
+
+void AGW_MapGenerator::GetBiomeDataForCoords(TArrayView<const FIntPoint> Coords, TArrayView<FGW_BiomeData> OutData) const
+{
+    checkf(OutData.Num() >= Coords.Num(), TEXT("GetBiomeDataForCoords: output holds %d tiles, %d needed"), OutData.Num(), Coords.Num());
+    
+    for (int32 i = 0; i < Coords.Num(); i++)
+    {
+        const FIntPoint& Pos = Coords[i];
+        OutData[i] = IsValidGridPosition(Pos) ? BiomeMap[GetTileIndex(Pos.X, Pos.Y)] : FGW_BiomeData();
+    }
+}
+
+void AGW_MapGenerator::GetBiomesForCoords(TArrayView<const FIntPoint> Coords, TArrayView<EGW_HexBiome> OutBiomes) const
+{
+    checkf(OutBiomes.Num() >= Coords.Num(), TEXT("GetBiomesForCoords: output holds %d tiles, %d needed"), OutBiomes.Num(), Coords.Num());
+    
+    for (int32 i = 0; i < Coords.Num(); i++)
+    {
+        const FIntPoint& Pos = Coords[i];
+        OutBiomes[i] = IsValidGridPosition(Pos) ? BiomeTypeMap[GetTileIndex(Pos.X, Pos.Y)] : EGW_HexBiome::Hill;
+    }
+}
+
+FGW_MapGenerationParams AGW_MapGenerator::GetGenerationParams() const
+{
+    FGW_MapGenerationParams Params;
+    Params.Seed = Seed;
+    Params.Width = GenWidth;
+    Params.Height = GenHeight;
+    Params.TemperaturePeriod = TemperaturePeriod;
+    Params.TemperatureOctaves = TemperatureOctaves;
+    Params.MoisturePeriod = MoisturePeriod;
+    Params.MoistureOctaves = MoistureOctaves;
+    Params.AltitudePeriod = AltitudePeriod;
+    Params.AltitudeOctaves = AltitudeOctaves;
+    Params.VolatilityPeriod = VolatilityPeriod;
+    Params.VolatilityOctaves = VolatilityOctaves;
+    Params.EnchantmentPeriod = EnchantmentPeriod;
+    Params.EnchantmentOctaves = EnchantmentOctaves;
+    Params.bGeneratePOIs = bGeneratePOIs;
+    Params.bGenerateRivers = bGenerateRivers;
+    return Params;
+}
+
+void AGW_MapGenerator::ApplyGenerationParams(const FGW_MapGenerationParams& Params)
+{
+    Seed = Params.Seed;
+    GenWidth = Params.Width;
+    GenHeight = Params.Height;
+    TemperaturePeriod = Params.TemperaturePeriod;
+    TemperatureOctaves = Params.TemperatureOctaves;
+    MoisturePeriod = Params.MoisturePeriod;
+    MoistureOctaves = Params.MoistureOctaves;
+    AltitudePeriod = Params.AltitudePeriod;
+    AltitudeOctaves = Params.AltitudeOctaves;
+    VolatilityPeriod = Params.VolatilityPeriod;
+    VolatilityOctaves = Params.VolatilityOctaves;
+    EnchantmentPeriod = Params.EnchantmentPeriod;
+    EnchantmentOctaves = Params.EnchantmentOctaves;
+    bGeneratePOIs = Params.bGeneratePOIs;
+    bGenerateRivers = Params.bGenerateRivers;
+}
+
+uint32 AGW_MapGenerator::GetSettingsHash() const
+{
+    uint32 Hash = GetTypeHash(GeneratorVersion);
+    Hash = HashCombine(Hash, GetTypeHash(POIMinSpacing));
+    Hash = HashCombine(Hash, GetTypeHash(POIMaxSpacing));
+    Hash = HashCombine(Hash, GetTypeHash(POITileSize));
+    Hash = HashCombine(Hash, GetTypeHash(RiverAccumulationThreshold));
+    
+    // Map iteration order depends on how the config was built, so every level is hashed in key order
+    auto HashWeights = [&Hash](const auto& Weights)
+    {
+        auto Keys = Weights.Array();
+        Keys.Sort([](const auto& A, const auto& B) { return (uint8)A.Key < (uint8)B.Key; });
+        for (const auto& Pair : Keys)
+        {
+            Hash = HashCombine(Hash, HashCombine(GetTypeHash(Pair.Key), GetTypeHash(Pair.Value)));
+        }
+        Hash = HashCombine(Hash, GetTypeHash(Keys.Num()));
+    };
+    
+    TArray<FString> BiomeNames;
+    BiomeDataConfig.GetKeys(BiomeNames);
+    BiomeNames.Sort();
+    for (const FString& BiomeName : BiomeNames)
+    {
+        const FGW_BiomeGenerationInfo& Info = BiomeDataConfig[BiomeName];
+        Hash = HashCombine(Hash, GetTypeHash(BiomeName));
+        HashWeights(Info.HexBiomeWeights);
+        HashWeights(Info.HexPOIWeights);
+        HashWeights(Info.MegagonWeights);
+    }
+    return Hash;
+}
+
+void AGW_MapGenerator::ExportGridSnapshot(TArray<uint8>& OutBytes) const
+{
+    // The noise maps are duplicated in FGW_BiomeData, so biomes and POIs are all we need
+    OutBytes.Reset(sizeof(int32) * 5 + BiomeMap.Num() * sizeof(FGW_BiomeData) + POILocations.Num() * sizeof(FIntPoint));
+    FMemoryWriter Writer(OutBytes);
+    
+    int32 Width = GenWidth;
+    int32 Height = GenHeight;
+    int32 SnapshotSeed = Seed;
+    int32 NumTiles = BiomeMap.Num();
+    int32 NumPOIs = POILocations.Num();
+    Writer << Width << Height << SnapshotSeed << NumTiles << NumPOIs;
+    Writer.Serialize(const_cast<FGW_BiomeData*>(BiomeMap.GetData()), NumTiles * sizeof(FGW_BiomeData));
+    Writer.Serialize(const_cast<FIntPoint*>(POILocations.GetData()), NumPOIs * sizeof(FIntPoint));
+}
+
+bool AGW_MapGenerator::ImportGridSnapshot(TArrayView<const uint8> Bytes)
+{
+    FMemoryReaderView Reader(Bytes);
+    
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 SnapshotSeed = 0;
+    int32 NumTiles = 0;
+    int32 NumPOIs = 0;
+    Reader << Width << Height << SnapshotSeed << NumTiles << NumPOIs;
+    
+    const int64 ExpectedSize = Reader.Tell() + int64(NumTiles) * sizeof(FGW_BiomeData) + int64(NumPOIs) * sizeof(FIntPoint);
+    if (Reader.IsError() || NumTiles != Width * Height || NumPOIs < 0 || ExpectedSize != Bytes.Num())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ImportGridSnapshot: snapshot is malformed."));
+        return false;
+    }
+    
+    GenWidth = Width;
+    GenHeight = Height;
+    Seed = SnapshotSeed;
+    
+    BiomeMap.SetNumUninitialized(NumTiles);
+    POILocations.SetNumUninitialized(NumPOIs);
+    Reader.Serialize(BiomeMap.GetData(), NumTiles * sizeof(FGW_BiomeData));
+    Reader.Serialize(POILocations.GetData(), NumPOIs * sizeof(FIntPoint));
+    
+    // Rebuild the derived per-channel maps
+    TemperatureMap.SetNumUninitialized(NumTiles);
+    MoistureMap.SetNumUninitialized(NumTiles);
+    AltitudeMap.SetNumUninitialized(NumTiles);
+    VolatilityMap.SetNumUninitialized(NumTiles);
+    EnchantmentMap.SetNumUninitialized(NumTiles);
+    BiomeTypeMap.SetNumUninitialized(NumTiles);
+    for (int32 Index = 0; Index < NumTiles; Index++)
+    {
+        const FGW_BiomeData& BiomeData = BiomeMap[Index];
+        TemperatureMap[Index] = BiomeData.Temperature;
+        MoistureMap[Index] = BiomeData.Moisture;
+        AltitudeMap[Index] = BiomeData.Altitude;
+        VolatilityMap[Index] = BiomeData.Volatility;
+        EnchantmentMap[Index] = BiomeData.Enchantment;
+        BiomeTypeMap[Index] = BiomeData.BiomeEntry;
+    }
+    
+    return true;
+}
+
+UTexture2D* AGW_MapGenerator::BuildBiomeTexture(TextureFilter Filter) const
+{
+    if (BiomeMap.Num() == 0 || BiomeMap.Num() != GenWidth * GenHeight)
+        return nullptr;
     
     // Create a new texture
     UTexture2D* Texture = UTexture2D::CreateTransient(GenWidth, GenHeight, PF_B8G8R8A8);
     if (!Texture)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to create texture."));
+        UE_LOG(LogTemp, Error, TEXT("BuildBiomeTexture: Failed to create a %dx%d texture."), GenWidth, GenHeight);
         return nullptr;
     }
+    Texture->Filter = Filter;
     
     // Lock the texture for editing
     FTexture2DMipMap& Mip = Texture->GetPlatformData()->Mips[0];
     void* Data = Mip.BulkData.Lock(LOCK_READ_WRITE);
     FColor* ColorData = static_cast<FColor*>(Data);
     
-    // Fill texture with biome colors
-    for (int32 Y = 0; Y < GenHeight; Y++)
+    // Fill texture with biome colors (the biome map is already in texel order)
+    for (int32 Index = 0; Index < BiomeMap.Num(); Index++)
     {
-        for (int32 X = 0; X < GenWidth; X++)
-        {
-            FIntPoint Pos(X, Y);
-            if (BiomeMap.Contains(Pos))
-            {
-                const FGW_BiomeData& BiomeData = BiomeMap[Pos];
-                FColor Color = GetColorForBiome(BiomeData.BiomeEntry);
-                ColorData[Y * GenWidth + X] = Color;
-            }
-            else
-            {
-                ColorData[Y * GenWidth + X] = FColor::Black;
-            }
-        }
+        ColorData[Index] = GetColorForBiome(BiomeMap[Index].BiomeEntry);
     }
     
     // Unlock and update
     Mip.BulkData.Unlock();
     Texture->UpdateResource();
     
-    UE_LOG(LogTemp, Log, TEXT("Debug texture generated successfully."));
+    return Texture;
+}
+
+UTexture2D* AGW_MapGenerator::GenerateTestDebugTexture()
+{
+    if (BiomeMap.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BiomeMap is empty. Generate biome map first."));
+        return nullptr;
+    }
     
+    UTexture2D* Texture = BuildBiomeTexture();
+    if (Texture)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Debug texture generated successfully."));
+    }
     return Texture;
 }
 
-FColor AGW_MapGenerator::GetColorForBiome(EGW_HexBiome Biome) const
+FColor AGW_MapGenerator::GetColorForBiome(EGW_HexBiome Biome)
 {
     switch (Biome)
     {
@@ -463,6 +1152,8 @@ FColor AGW_MapGenerator::GetColorForBiome(EGW_HexBiome Biome) const
             return FColor(175, 238, 238);           // Pale Turquoise
         case EGW_HexBiome::Water:
             return FColor(65, 105, 225);            // Royal Blue
+        case EGW_HexBiome::River:
+            return FColor(100, 149, 237);           // Cornflower Blue
         case EGW_HexBiome::GreatPeak:
             return FColor(255, 255, 255);           // White (snow-capped peaks)
         default:
@@ -470,4 +1161,74 @@ FColor AGW_MapGenerator::GetColorForBiome(EGW_HexBiome Biome) const
     }
 }
 #pragma endregion
+
+
+
+#pragma region FGW_POIAliasTable
+void FGW_POIAliasTable::Build(const TMap<EGW_HexPOI, float>& Weights)
+{
+    Entries.Reset();
+    Probabilities.Reset();
+    Aliases.Reset();
+    
+    float TotalWeight = 0.0f;
+    for (const auto& Pair : Weights)
+    {
+        if (Pair.Value > 0.0f && Pair.Key != EGW_HexPOI::None)
+        {
+            Entries.Add(Pair.Key);
+            Probabilities.Add(Pair.Value);
+            TotalWeight += Pair.Value;
+        }
+    }
+    
+    const int32 Num = Entries.Num();
+    if (Num == 0)
+    {
+        return;
+    }
+    
+    // Vose's method: scale to an average of 1, then pair each small column with a large one
+    Aliases.Init(INDEX_NONE, Num);
+    TArray<int32> Small;
+    TArray<int32> Large;
+    for (int32 i = 0; i < Num; i++)
+    {
+        Probabilities[i] *= Num / TotalWeight;
+        (Probabilities[i] < 1.0f ? Small : Large).Add(i);
+    }
+    
+    while (Small.Num() > 0 && Large.Num() > 0)
+    {
+        const int32 Less = Small.Pop(EAllowShrinking::No);
+        const int32 More = Large.Pop(EAllowShrinking::No);
+        
+        Aliases[Less] = More;
+        Probabilities[More] = (Probabilities[More] + Probabilities[Less]) - 1.0f;
+        (Probabilities[More] < 1.0f ? Small : Large).Add(More);
+    }
+    
+    // Leftovers are only off from 1 by float error
+    for (int32 Index : Small)
+    {
+        Probabilities[Index] = 1.0f;
+    }
+    for (int32 Index : Large)
+    {
+        Probabilities[Index] = 1.0f;
+    }
+}
+
+EGW_HexPOI FGW_POIAliasTable::Sample(FRandomStream& Stream) const
+{
+    if (Entries.Num() == 0)
+    {
+        return EGW_HexPOI::None;
+    }
+    
+    const int32 Column = Stream.RandHelper(Entries.Num());
+    const bool bUseColumn = Stream.FRand() < Probabilities[Column];
+    return Entries[bUseColumn ? Column : Aliases[Column]];
+}
+#pragma endregion
 /*-------------------------------------------------------------------------*/
\ No newline at end of file
@@ -0,0 +1,130 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Core/ExplorationMap/Widgets/GW_HexMapCanvas.h"
+#include "Core/ExplorationMap/Widgets/SGW_HexMapCanvas.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Functions                                                              */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexMapCanvas.cpp
+void UGW_HexMapCanvas::SetWorldState(const UGW_HexWorldState* InWorldState)
+{
+    WorldState = InWorldState;
+    if (MyHexCanvas.IsValid())
+    {
+        MyHexCanvas->SetWorldState(InWorldState);
+    }
+}
+
+void UGW_HexMapCanvas::SetView(const FVector2D& InViewOffset, float InZoom, const FVector2D& InHexSize)
+{
+    ViewOffset = InViewOffset;
+    Zoom = InZoom;
+    HexSize = InHexSize;
+    if (MyHexCanvas.IsValid())
+    {
+        MyHexCanvas->SetView(ViewOffset, Zoom, HexSize);
+    }
+}
+
+void UGW_HexMapCanvas::SetVisibleRect(const FIntRect& InVisibleRect)
+{
+    VisibleRect = InVisibleRect;
+    if (MyHexCanvas.IsValid())
+    {
+        MyHexCanvas->SetVisibleRect(VisibleRect);
+    }
+}
+
+void UGW_HexMapCanvas::SetHexList(TArrayView<const FIntPoint> InHexList)
+{
+    HexList.Reset();
+    HexList.Append(InHexList.GetData(), InHexList.Num());
+    bUseHexList = true;
+    if (MyHexCanvas.IsValid())
+    {
+        MyHexCanvas->SetHexList(HexList);
+    }
+}
+
+void UGW_HexMapCanvas::ClearHexList()
+{
+    HexList.Reset();
+    bUseHexList = false;
+    if (MyHexCanvas.IsValid())
+    {
+        MyHexCanvas->ClearHexList();
+    }
+}
+
+void UGW_HexMapCanvas::SetStateTransitions(TArrayView<const FGW_HexTileTransition> InTransitions)
+{
+    Transitions.Reset();
+    Transitions.Append(InTransitions.GetData(), InTransitions.Num());
+    if (MyHexCanvas.IsValid())
+    {
+        MyHexCanvas->SetStateTransitions(Transitions);
+    }
+}
+
+void UGW_HexMapCanvas::RequestRepaint()
+{
+    if (MyHexCanvas.IsValid())
+    {
+        MyHexCanvas->RequestRepaint();
+    }
+}
+
+void UGW_HexMapCanvas::SyncFog()
+{
+    if (MyHexCanvas.IsValid())
+    {
+        MyHexCanvas->SetFog(bDrawFog, HiddenFogColor, ExploredFogColor);
+    }
+}
+
+void UGW_HexMapCanvas::SynchronizeProperties()
+{
+    Super::SynchronizeProperties();
+    
+    if (MyHexCanvas.IsValid())
+    {
+        MyHexCanvas->SetHexBrush(&HexBrush);
+        MyHexCanvas->SetWorldState(WorldState.Get());
+        MyHexCanvas->SetView(ViewOffset, Zoom, HexSize);
+        MyHexCanvas->SetVisibleRect(VisibleRect);
+        
+        if (bUseHexList)
+        {
+            MyHexCanvas->SetHexList(HexList);
+        }
+        else
+        {
+            MyHexCanvas->ClearHexList();
+        }
+        
+        MyHexCanvas->SetStateTransitions(Transitions);
+        SyncFog();
+    }
+}
+
+void UGW_HexMapCanvas::ReleaseSlateResources(bool bReleaseChildren)
+{
+    Super::ReleaseSlateResources(bReleaseChildren);
+    
+    MyHexCanvas.Reset();
+}
+
+TSharedRef<SWidget> UGW_HexMapCanvas::RebuildWidget()
+{
+    MyHexCanvas = SNew(SGW_HexMapCanvas)
+        .HexBrush(&HexBrush);
+    
+    return MyHexCanvas.ToSharedRef();
+}
+#pragma endregion
+/*-------------------------------------------------------------------------*/
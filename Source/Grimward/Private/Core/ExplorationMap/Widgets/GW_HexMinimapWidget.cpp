@@ -0,0 +1,193 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Core/ExplorationMap/Widgets/GW_HexMinimapWidget.h"
+#include "Core/ExplorationMap/GW_ExplorableHexMap.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Components/Image.h"
+#include "Rendering/DrawElements.h"
+#include "Grimward.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Functions                                                              */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexMinimapWidget.cpp
+void UGW_HexMinimapWidget::NativeConstruct()
+{
+    Super::NativeConstruct();
+    
+    bIsDragging = false;
+}
+
+void UGW_HexMinimapWidget::NativeDestruct()
+{
+    UnbindWorldState();
+    
+    Super::NativeDestruct();
+}
+
+void UGW_HexMinimapWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+    Super::NativeTick(MyGeometry, InDeltaTime);
+    
+    // Every change since the last frame goes up in one upload
+    StateTexture.Flush(WorldState);
+}
+
+void UGW_HexMinimapWidget::SetHexMap(UGW_ExplorableHexMap* InHexMap)
+{
+    UnbindWorldState();
+    
+    HexMap = InHexMap;
+    WorldState = HexMap ? HexMap->GetHexWorldState() : nullptr;
+    if (WorldState)
+    {
+        ExplorationChangedHandle = WorldState->OnExplorationChanged().AddUObject(this, &UGW_HexMinimapWidget::OnExplorationChanged);
+    }
+    
+    RebuildTexture();
+}
+
+void UGW_HexMinimapWidget::RebuildTexture()
+{
+    // Conquered hexes keep a hint of their biome under the tint; explored ones show it plain
+    StateTexture.SetTints(HiddenColor, FLinearColor::Transparent,
+        FLinearColor(ConqueredTint.R, ConqueredTint.G, ConqueredTint.B, ConqueredTintStrength));
+    
+    // One texel per hex; nearest filtering keeps single hexes visible when magnified
+    const bool bBuilt = StateTexture.Rebuild(WorldState, TF_Nearest);
+    if (MinimapImage)
+    {
+        MinimapImage->SetBrushFromTexture(StateTexture.Texture);
+    }
+    
+    if (bBuilt)
+    {
+        UE_LOG(LogGrimwardHexMap, Log, TEXT("HexMinimap: Built %dx%d texture"), StateTexture.Size.X, StateTexture.Size.Y);
+    }
+}
+
+// ========================================
+// Texture Updates
+// ========================================
+
+void UGW_HexMinimapWidget::OnExplorationChanged(const FIntRect& DirtyRect)
+{
+    // A resized store is a different map; rebuild rather than patch
+    if (!WorldState || WorldState->GetMapSize() != StateTexture.Size)
+    {
+        RebuildTexture();
+        return;
+    }
+    
+    StateTexture.AddPendingRegion(DirtyRect);
+}
+
+void UGW_HexMinimapWidget::UnbindWorldState()
+{
+    if (WorldState)
+    {
+        WorldState->OnExplorationChanged().Remove(ExplorationChangedHandle);
+    }
+    ExplorationChangedHandle.Reset();
+    WorldState = nullptr;
+}
+
+// ========================================
+// Painting
+// ========================================
+
+int32 UGW_HexMinimapWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    const int32 MaxLayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+    
+    if (!HexMap || !MinimapImage || StateTexture.Size.X <= 0)
+        return MaxLayerId;
+    
+    const FBox2D View = HexMap->GetViewGridBounds();
+    const FGeometry& ImageGeometry = MinimapImage->GetCachedGeometry();
+    const FVector2D ImageSize = ImageGeometry.GetLocalSize();
+    if (!View.bIsValid || ImageSize.IsNearlyZero())
+        return MaxLayerId;
+    
+    // Grid units -> image-local -> our local space, clamped so the frame stays on the minimap
+    const FVector2D GridToImage = ImageSize / FVector2D(StateTexture.Size);
+    auto ToLocal = [&](FVector2D GridPos)
+    {
+        const FVector2D ImageLocal = (GridPos * GridToImage).ComponentMax(FVector2D::ZeroVector).ComponentMin(ImageSize);
+        return FVector2f(AllottedGeometry.AbsoluteToLocal(ImageGeometry.LocalToAbsolute(ImageLocal)));
+    };
+    
+    const FVector2f TopLeft = ToLocal(View.Min);
+    const FVector2f BottomRight = ToLocal(View.Max);
+    TArray<FVector2f> Points;
+    Points.Reserve(5);
+    Points.Add(TopLeft);
+    Points.Add(FVector2f(BottomRight.X, TopLeft.Y));
+    Points.Add(BottomRight);
+    Points.Add(FVector2f(TopLeft.X, BottomRight.Y));
+    Points.Add(TopLeft);
+    
+    FSlateDrawElement::MakeLines(OutDrawElements, MaxLayerId + 1, AllottedGeometry.ToPaintGeometry(), Points,
+        ESlateDrawEffect::None, ViewportRectColor * InWidgetStyle.GetColorAndOpacityTint(), true, ViewportRectThickness);
+    
+    return MaxLayerId + 1;
+}
+
+// ========================================
+// Input Handling
+// ========================================
+
+FReply UGW_HexMinimapWidget::NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+    if (InMouseEvent.GetEffectingButton() != EKeys::LeftMouseButton || !HexMap || StateTexture.Size.X <= 0)
+        return Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
+    
+    bIsDragging = true;
+    CenterHexMapAt(InMouseEvent.GetScreenSpacePosition());
+    return FReply::Handled().CaptureMouse(TakeWidget());
+}
+
+FReply UGW_HexMinimapWidget::NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+    if (InMouseEvent.GetEffectingButton() != EKeys::LeftMouseButton || !bIsDragging)
+        return Super::NativeOnMouseButtonUp(InGeometry, InMouseEvent);
+    
+    bIsDragging = false;
+    return FReply::Handled().ReleaseMouseCapture();
+}
+
+FReply UGW_HexMinimapWidget::NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+    if (!bIsDragging)
+        return Super::NativeOnMouseMove(InGeometry, InMouseEvent);
+    
+    CenterHexMapAt(InMouseEvent.GetScreenSpacePosition());
+    return FReply::Handled();
+}
+
+FIntPoint UGW_HexMinimapWidget::ScreenToGrid(FVector2D ScreenSpacePos) const
+{
+    const FGeometry& ImageGeometry = MinimapImage ? MinimapImage->GetCachedGeometry() : GetCachedGeometry();
+    const FVector2D ImageSize = ImageGeometry.GetLocalSize();
+    if (ImageSize.IsNearlyZero() || StateTexture.Size.X <= 0)
+        return FIntPoint::ZeroValue;
+    
+    const FVector2D GridPos = ImageGeometry.AbsoluteToLocal(ScreenSpacePos) / ImageSize * FVector2D(StateTexture.Size);
+    return FIntPoint(
+        FMath::Clamp(FMath::FloorToInt32(GridPos.X), 0, StateTexture.Size.X - 1),
+        FMath::Clamp(FMath::FloorToInt32(GridPos.Y), 0, StateTexture.Size.Y - 1));
+}
+
+void UGW_HexMinimapWidget::CenterHexMapAt(FVector2D ScreenSpacePos)
+{
+    if (HexMap)
+    {
+        HexMap->CenterOnGridPosition(ScreenToGrid(ScreenSpacePos));
+    }
+}
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -3,7 +3,7 @@
 #include "Core/ExplorationMap/Widgets/GW_HexTile.h"
 #include "Components/Image.h"
 #include "Components/Overlay.h"
-#include "Components/Button.h"
+#include "Core/ExplorationMap/GW_HexVisualsAsset.h"
 #include "Grimward.h"
 /*-------------------------------------------------------------------------*/
 
@@ -13,18 +13,28 @@
 /*  Functions                                                              */
 /*-------------------------------------------------------------------------*/
 #pragma region GW_HexTile.cpp
-void UGW_HexTile::NativeConstruct()
+void UGW_HexTile::NativeOnInitialized()
 {
-    Super::NativeConstruct();
+    Super::NativeOnInitialized();
     
-    // Bind button events
-    if (TileButton)
+    if (BiomeImage)
     {
-        TileButton->OnClicked.AddDynamic(this, &UGW_HexTile::OnTileClicked);
-        TileButton->OnHovered.AddDynamic(this, &UGW_HexTile::OnTileHovered);
-        TileButton->OnUnhovered.AddDynamic(this, &UGW_HexTile::OnTileUnhovered);
+        DefaultBiomeBrush = BiomeImage->GetBrush();
     }
     
+    if (TilePOI)
+    {
+        DefaultPOIBrush = TilePOI->GetBrush();
+    }
+}
+
+void UGW_HexTile::NativeConstruct()
+{
+    Super::NativeConstruct();
+    
+    // The map resolves the hex under the cursor analytically, so tiles never need hit-testing
+    SetVisibility(ESlateVisibility::HitTestInvisible);
+    
     // Initialize as hidden by default
     bIsSelected = false;
     if (SelectionBorder)
@@ -41,60 +51,96 @@ void UGW_HexTile::InitializeTile(const FGW_HexTileData& InTileData, FVector2D In
     // Update visuals based on tile data
     UpdateBiomeVisuals(TileData.BiomeType);
     UpdatePOIVisuals(TileData.POIType);
-    SetTileState(TileData.TileState);
+    ApplyStateTransition(TileData.TileState, TileData.TileState, 1.0f);
     
-    UE_LOG(LogGrimward, Log, TEXT("Initialized HexTile at grid position (%d, %d), pixel position (%.1f, %.1f)"),
+    UE_LOG(LogGrimwardHexMap, VeryVerbose, TEXT("Initialized HexTile at grid position (%d, %d), pixel position (%.1f, %.1f)"),
         TileData.GridPosition.X, TileData.GridPosition.Y, PixelPosition.X, PixelPosition.Y);
 }
 
+void UGW_HexTile::ApplyTileData(const FGW_HexTileData& InTileData)
+{
+    const FGW_HexTileData Previous = TileData;
+    TileData = InTileData;
+    
+    if (Previous.BiomeType != TileData.BiomeType)
+    {
+        UpdateBiomeVisuals(TileData.BiomeType);
+    }
+    
+    if (Previous.POIType != TileData.POIType)
+    {
+        UpdatePOIVisuals(TileData.POIType);
+    }
+    
+    // No BP event here; the map eases visible changes in through ApplyStateTransition
+    if (Previous.TileState != TileData.TileState)
+    {
+        ApplyStateTransition(TileData.TileState, TileData.TileState, 1.0f);
+    }
+}
+
+void UGW_HexTile::RefreshVisuals()
+{
+    UpdateBiomeVisuals(TileData.BiomeType);
+    UpdatePOIVisuals(TileData.POIType);
+}
+
 void UGW_HexTile::SetTileState(EGW_HexTileState NewState)
 {
     TileData.TileState = NewState;
+    ApplyStateTransition(NewState, NewState, 1.0f);
     
-    // Update fog overlay visibility
-    if (FogOverlay)
+    // Call blueprint event for custom animations
+    BP_OnStateChanged(NewState);
+}
+
+void UGW_HexTile::ApplyStateTransition(EGW_HexTileState From, EGW_HexTileState To, float Alpha)
+{
+    auto GetFogOpacity = [](EGW_HexTileState State)
     {
-        switch (NewState)
+        switch (State)
         {
             case EGW_HexTileState::Hidden:
-                FogOverlay->SetVisibility(ESlateVisibility::Visible);
-                FogOverlay->SetOpacity(1.0f);
-                break;
-                
+                return 1.0f;
+            
             case EGW_HexTileState::Explored:
-                FogOverlay->SetVisibility(ESlateVisibility::Visible);
-                FogOverlay->SetOpacity(0.3f); // Semi-transparent
-                break;
-                
-            case EGW_HexTileState::Conquered:
-                FogOverlay->SetVisibility(ESlateVisibility::Collapsed);
-                break;
+                return 0.3f; // Semi-transparent
+            
+            default:
+                return 0.0f;
         }
+    };
+    
+    auto GetConqueredOpacity = [](EGW_HexTileState State)
+    {
+        return State == EGW_HexTileState::Conquered ? 1.0f : 0.0f;
+    };
+    
+    // Update fog overlay (the map's fog layer covers it otherwise)
+    if (FogOverlay)
+    {
+        const float Opacity = bUseFogOverlay ? FMath::Lerp(GetFogOpacity(From), GetFogOpacity(To), Alpha) : 0.0f;
+        FogOverlay->SetVisibility(Opacity > 0.0f ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
+        FogOverlay->SetOpacity(Opacity);
     }
     
     // Update conquered overlay
     if (ConqueredOverlay)
     {
-        ConqueredOverlay->SetVisibility(
-            NewState == EGW_HexTileState::Conquered ? 
-            ESlateVisibility::Visible : 
-            ESlateVisibility::Collapsed
-        );
+        const float Opacity = FMath::Lerp(GetConqueredOpacity(From), GetConqueredOpacity(To), Alpha);
+        ConqueredOverlay->SetVisibility(Opacity > 0.0f ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
+        ConqueredOverlay->SetRenderOpacity(Opacity);
     }
-    
-    // Call blueprint event for custom animations
-    BP_OnStateChanged(NewState);
 }
 
 void UGW_HexTile::UpdateBiomeVisuals(EGW_HexBiome Biome)
 {
-    // TODO: Load actual biome textures from data asset
-    // For now this is a placeholder
-    if (BiomeImage)
-    {
-        // You'll implement texture loading from your data asset here
-        UE_LOG(LogGrimward, Log, TEXT("UpdateBiomeVisuals called for biome type %d"), (int32)Biome);
-    }
+    if (!BiomeImage)
+        return;
+    
+    // Null until the atlas has streamed in (never loads synchronously); a pooled tile must not keep its last hex's brush
+    const FSlateBrush* Brush = Visuals ? Visuals->GetBiomeBrush(Biome) : nullptr;
+    BiomeImage->SetBrush(Brush ? *Brush : DefaultBiomeBrush);
 }
 
 void UGW_HexTile::UpdatePOIVisuals(EGW_HexPOI POI)
@@ -109,8 +155,9 @@ void UGW_HexTile::UpdatePOIVisuals(EGW_HexPOI POI)
     else
     {
         TilePOI->SetVisibility(ESlateVisibility::Visible);
-        // TODO: Load actual POI icon textures from data asset
-        UE_LOG(LogGrimward, Log, TEXT("UpdatePOIVisuals called for POI type %d"), (int32)POI);
+        
+        const FSlateBrush* Brush = Visuals ? Visuals->GetPOIBrush(POI) : nullptr;
+        TilePOI->SetBrush(Brush ? *Brush : DefaultPOIBrush);
     }
 }
 
@@ -128,7 +175,7 @@ void UGW_HexTile::SetSelected(bool bSelected)
 
 void UGW_HexTile::OnTileClicked()
 {
-    UE_LOG(LogGrimward, Log, TEXT("Tile clicked at grid position (%d, %d)"), 
+    UE_LOG(LogGrimwardHexMap, Verbose, TEXT("Tile clicked at grid position (%d, %d)"), 
         TileData.GridPosition.X, TileData.GridPosition.Y);
     
     // Call blueprint event for custom click handling
@@ -0,0 +1,305 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Core/ExplorationMap/Widgets/SGW_HexMapCanvas.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Core/ExplorationMap/GW_HexMath.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/DrawElements.h"
+#include "Rendering/SlateRenderer.h"
+#include "Styling/CoreStyle.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Functions                                                              */
+/*-------------------------------------------------------------------------*/
+#pragma region SGW_HexMapCanvas.cpp
+const FVector2f SGW_HexMapCanvas::HexCorners[6] = {
+    FVector2f(1.0f, 0.0f), FVector2f(0.5f, 1.0f), FVector2f(-0.5f, 1.0f),
+    FVector2f(-1.0f, 0.0f), FVector2f(-0.5f, -1.0f), FVector2f(0.5f, -1.0f)
+};
+
+void SGW_HexMapCanvas::Construct(const FArguments& InArgs)
+{
+    HexBrush = InArgs._HexBrush;
+}
+
+void SGW_HexMapCanvas::SetHexBrush(const FSlateBrush* InHexBrush)
+{
+    if (HexBrush == InHexBrush)
+        return;
+    
+    HexBrush = InHexBrush;
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SGW_HexMapCanvas::SetWorldState(const UGW_HexWorldState* InWorldState)
+{
+    if (WorldState.Get() == InWorldState)
+        return;
+    
+    WorldState = InWorldState;
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SGW_HexMapCanvas::SetView(const FVector2D& InViewOffset, float InZoom, const FVector2D& InHexSize)
+{
+    // Unchanged state must not invalidate, or a cached map repaints on every idle visibility pass
+    if (ViewOffset == InViewOffset && Zoom == InZoom && HexSize == InHexSize)
+        return;
+    
+    ViewOffset = InViewOffset;
+    Zoom = InZoom;
+    HexSize = InHexSize;
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SGW_HexMapCanvas::SetVisibleRect(const FIntRect& InVisibleRect)
+{
+    if (VisibleRect == InVisibleRect)
+        return;
+    
+    VisibleRect = InVisibleRect;
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SGW_HexMapCanvas::SetHexList(TArrayView<const FIntPoint> InHexList)
+{
+    if (bUseHexList && HexList.Num() == InHexList.Num()
+        && FMemory::Memcmp(HexList.GetData(), InHexList.GetData(), HexList.Num() * sizeof(FIntPoint)) == 0)
+    {
+        return;
+    }
+    
+    HexList.Reset();
+    HexList.Append(InHexList.GetData(), InHexList.Num());
+    bUseHexList = true;
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SGW_HexMapCanvas::ClearHexList()
+{
+    if (!bUseHexList)
+        return;
+    
+    HexList.Reset();
+    bUseHexList = false;
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SGW_HexMapCanvas::SetFog(bool bInDrawFog, const FLinearColor& InHiddenColor, const FLinearColor& InExploredColor)
+{
+    if (bDrawFog == bInDrawFog && HiddenFogColor == InHiddenColor && ExploredFogColor == InExploredColor)
+        return;
+    
+    bDrawFog = bInDrawFog;
+    HiddenFogColor = InHiddenColor;
+    ExploredFogColor = InExploredColor;
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SGW_HexMapCanvas::SetStateTransitions(TArrayView<const FGW_HexTileTransition> InTransitions)
+{
+    if (Transitions.Num() == 0 && InTransitions.Num() == 0)
+        return;
+    
+    Transitions.Reset();
+    Transitions.Append(InTransitions.GetData(), InTransitions.Num());
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+FLinearColor SGW_HexMapCanvas::GetFogColor(EGW_HexTileState State) const
+{
+    switch (State)
+    {
+        case EGW_HexTileState::Hidden:
+            return HiddenFogColor;
+        
+        case EGW_HexTileState::Explored:
+            return ExploredFogColor;
+        
+        default:
+            return FLinearColor(ExploredFogColor.R, ExploredFogColor.G, ExploredFogColor.B, 0.0f);
+    }
+}
+
+void SGW_HexMapCanvas::RequestRepaint()
+{
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+int32 SGW_HexMapCanvas::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    const UGW_HexWorldState* MapState = WorldState.Get();
+    if (!MapState)
+    {
+        return LayerId;
+    }
+    
+    // Fog layers paint the exploration state of the whole rectangle
+    const bool bFogLayer = bDrawFog;
+    const bool bListMode = bUseHexList && !bFogLayer;
+    
+    const FIntRect Rect = MapState->ClipRectToMap(VisibleRect);
+    const int32 NumHexes = bListMode ? HexList.Num() : Rect.Area();
+    if (NumHexes <= 0)
+    {
+        return LayerId;
+    }
+    
+    // One biome (or state) read for the whole rectangle (or list)
+    if (bFogLayer)
+    {
+        StateScratch.SetNumZeroed(NumHexes, EAllowShrinking::No);
+        MapState->GetTileStatesInRect(Rect, StateScratch);
+    }
+    else
+    {
+        BiomeScratch.SetNumUninitialized(NumHexes, EAllowShrinking::No);
+        if (bListMode)
+        {
+            MapState->GetBiomesForCoords(HexList, BiomeScratch);
+        }
+        else
+        {
+            MapState->GetBiomesInRect(Rect, BiomeScratch);
+        }
+    }
+    
+    // Fan of 6 triangles around the centre vertex per hex
+    Vertices.Reset(NumHexes * 7);
+    Indices.Reset(NumHexes * 18);
+    
+    const FSlateRenderTransform& Transform = AllottedGeometry.GetAccumulatedRenderTransform();
+    const FVector2f HalfSize = FVector2f(HexSize * 0.5 * Zoom);
+    const FLinearColor WidgetTint = InWidgetStyle.GetColorAndOpacityTint();
+    
+    const FVector2f LocalSize = FVector2f(AllottedGeometry.GetLocalSize());
+    
+    auto AppendHex = [&](int32 X, int32 Y, const FColor& Color)
+    {
+        // Same layout as UGW_ExplorableHexMap::GridToPixel, moved to the hex centre
+        const FVector2D PixelPos = GW_HexMath::GridToPixelCenter(FIntPoint(X, Y), HexSize);
+        const FVector2f Centre = FVector2f((PixelPos + ViewOffset) * Zoom);
+        
+        // Skip hexes that fall entirely outside the widget
+        if (Centre.X + HalfSize.X < 0.0f || Centre.Y + HalfSize.Y < 0.0f
+            || Centre.X - HalfSize.X > LocalSize.X || Centre.Y - HalfSize.Y > LocalSize.Y)
+        {
+            return;
+        }
+        
+        const SlateIndex First = Vertices.Num();
+        
+        Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(Transform, Centre, FVector2f(0.5f, 0.5f), Color));
+        for (int32 Corner = 0; Corner < 6; Corner++)
+        {
+            const FVector2f& Offset = HexCorners[Corner];
+            Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(Transform,
+                Centre + Offset * HalfSize, FVector2f(0.5f, 0.5f) + Offset * 0.5f, Color));
+            
+            Indices.Add(First);
+            Indices.Add(First + 1 + Corner);
+            Indices.Add(First + 1 + (Corner + 1) % 6);
+        }
+    };
+    
+    auto GetBiomeColor = [&WidgetTint](EGW_HexBiome Biome)
+    {
+        return (FLinearColor(AGW_MapGenerator::GetColorForBiome(Biome)) * WidgetTint).ToFColor(true);
+    };
+    
+    if (bFogLayer)
+    {
+        const FColor HiddenColor = (HiddenFogColor * WidgetTint).ToFColor(true);
+        const FColor ExploredColor = (ExploredFogColor * WidgetTint).ToFColor(true);
+        
+        // Transitioning hexes are blended here and masked out of the stored-state pass below
+        const bool bHasTransitions = Transitions.Num() > 0;
+        if (bHasTransitions)
+        {
+            TransitionMask.Init(false, NumHexes);
+        }
+        
+        for (const FGW_HexTileTransition& Transition : Transitions)
+        {
+            if (!Rect.Contains(Transition.GridPosition))
+                continue;
+            
+            const FIntPoint Local = Transition.GridPosition - Rect.Min;
+            TransitionMask[Local.Y * Rect.Width() + Local.X] = true;
+            
+            const FLinearColor Blended = FMath::Lerp(GetFogColor(Transition.From), GetFogColor(Transition.To), Transition.Alpha);
+            if (Blended.A > 0.0f)
+            {
+                AppendHex(Transition.GridPosition.X, Transition.GridPosition.Y, (Blended * WidgetTint).ToFColor(true));
+            }
+        }
+        
+        int32 StateIndex = 0;
+        for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; Y++)
+        {
+            for (int32 X = Rect.Min.X; X < Rect.Max.X; X++, StateIndex++)
+            {
+                if (bHasTransitions && TransitionMask[StateIndex])
+                    continue;
+                
+                // Conquered hexes are fully uncovered
+                switch (StateScratch[StateIndex])
+                {
+                    case EGW_HexTileState::Hidden:
+                        AppendHex(X, Y, HiddenColor);
+                        break;
+                        
+                    case EGW_HexTileState::Explored:
+                        AppendHex(X, Y, ExploredColor);
+                        break;
+                        
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+    else if (bListMode)
+    {
+        for (int32 i = 0; i < HexList.Num(); i++)
+        {
+            if (Rect.Contains(HexList[i]))
+            {
+                AppendHex(HexList[i].X, HexList[i].Y, GetBiomeColor(BiomeScratch[i]));
+            }
+        }
+    }
+    else
+    {
+        int32 BiomeIndex = 0;
+        for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; Y++)
+        {
+            for (int32 X = Rect.Min.X; X < Rect.Max.X; X++, BiomeIndex++)
+            {
+                AppendHex(X, Y, GetBiomeColor(BiomeScratch[BiomeIndex]));
+            }
+        }
+    }
+    
+    if (Vertices.Num() > 0)
+    {
+        const FSlateBrush* Brush = HexBrush ? HexBrush : FCoreStyle::Get().GetBrush("WhiteBrush");
+        const FSlateResourceHandle Handle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(*Brush);
+        FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, Handle, Vertices, Indices, nullptr, 0, 0);
+    }
+    
+    return LayerId;
+}
+
+FVector2D SGW_HexMapCanvas::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+    // Fills whatever slot it is given
+    return FVector2D::ZeroVector;
+}
+#pragma endregion
+/*-------------------------------------------------------------------------*/
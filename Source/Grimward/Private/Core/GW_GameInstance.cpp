@@ -2,6 +2,8 @@
 /*-------------------------------------------------------------------------*/
 #include "Public/Core/GW_GameInstance.h"
 #include "Public/Core/GW_SaveGame.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
 #include "Kismet/GameplayStatics.h"
 /*-------------------------------------------------------------------------*/
 
@@ -190,8 +192,28 @@ void UGW_GameInstance::SaveGame()
     {
         SaveGameInstance->PlayerProfile = PlayerProfile;
         
+        // Outside the exploration map, or when the store has not changed since the last save,
+        // the last saved exploration is carried over; only a changed map is encoded again
+        const UGW_HexWorldState* WorldState = GetHexWorldState();
+        const bool bExplorationChanged = WorldState && WorldState->GetMapKey() != 0
+            && (!CurrentSaveGame || SavedExplorationSource.Get() != WorldState || SavedExplorationRevision != WorldState->GetRevision());
+        if (bExplorationChanged)
+        {
+            WorldState->ExportExploration(SaveGameInstance->Exploration);
+        }
+        else if (CurrentSaveGame)
+        {
+            SaveGameInstance->Exploration = CurrentSaveGame->Exploration;
+        }
+        
         if (UGameplayStatics::SaveGameToSlot(SaveGameInstance, SaveSlotName, 0))
         {
+            CurrentSaveGame = SaveGameInstance;
+            if (bExplorationChanged)
+            {
+                SavedExplorationSource = WorldState;
+                SavedExplorationRevision = WorldState->GetRevision();
+            }
             UE_LOG(LogTemp, Log, TEXT("[Grimward] Game saved successfully"));
         }
     }
@@ -208,6 +230,8 @@ void UGW_GameInstance::LoadGame()
         if (LoadedGame)
         {
             PlayerProfile = LoadedGame->PlayerProfile;
+            CurrentSaveGame = LoadedGame;
+            SavedExplorationSource.Reset();
             UE_LOG(LogTemp, Log, TEXT("[Grimward] Game loaded successfully"));
         }
     }
@@ -221,8 +245,52 @@ void UGW_GameInstance::ResetProgress()
 {
     PlayerProfile = FGW_PlayerProfile();
     PlayerProfile.UnlockedLevels.Add(FName("Level_01"));
+    CurrentSaveGame = nullptr;
+    if (UGW_HexWorldState* WorldState = GetHexWorldState())
+    {
+        WorldState->ResetExploration(WorldState->GetMapSize().X, WorldState->GetMapSize().Y);
+    }
     SaveGame();
     UE_LOG(LogTemp, Log, TEXT("[Grimward] Progress reset"));
 }
+
+bool UGW_GameInstance::RegenerateSavedMap(AGW_MapGenerator* MapGenerator)
+{
+    if (!MapGenerator || !CurrentSaveGame || !CurrentSaveGame->Exploration.HasMap())
+        return false;
+    
+    const FGW_ExplorationSaveData& Exploration = CurrentSaveGame->Exploration;
+    
+    // Settings outside the params (and the generator code itself) cannot be restored, only checked
+    if (MapGenerator->GetSettingsHash() != Exploration.GeneratorSettingsHash)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[Grimward] Map generator settings changed since the save, exploration of seed %d cannot be restored"),
+            Exploration.Params.Seed);
+        return false;
+    }
+    
+    MapGenerator->ApplyGenerationParams(Exploration.Params);
+    MapGenerator->GenerateBiomeMap(Exploration.Params.Seed);
+    return true;
+}
+
+bool UGW_GameInstance::RestoreSavedExploration()
+{
+    UGW_HexWorldState* WorldState = GetHexWorldState();
+    if (!WorldState || !CurrentSaveGame || !CurrentSaveGame->Exploration.HasMap())
+        return false;
+    
+    if (!WorldState->ImportExploration(CurrentSaveGame->Exploration))
+        return false;
+    
+    UE_LOG(LogTemp, Log, TEXT("[Grimward] Exploration restored (seed %d)"), CurrentSaveGame->Exploration.Params.Seed);
+    return true;
+}
+
+UGW_HexWorldState* UGW_GameInstance::GetHexWorldState() const
+{
+    const UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<UGW_HexWorldState>() : nullptr;
+}
 #pragma endregion
 /*-------------------------------------------------------------------------*/
\ No newline at end of file
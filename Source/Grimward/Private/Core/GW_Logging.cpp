@@ -0,0 +1,40 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Core/GW_Logging.h"
+#include "HAL/IConsoleManager.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Console Variables                                                      */
+/*-------------------------------------------------------------------------*/
+static TAutoConsoleVariable<float> CVarLogRateLimitScale(
+    TEXT("gw.Log.RateLimitScale"),
+    1.0f,
+    TEXT("Multiplier on the interval of every rate-limited Grimward log line (0 = no rate limit)."),
+    ECVF_Default);
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Functions                                                              */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_Logging.cpp
+bool FGW_LogRateLimiter::TryLog(int32& OutSuppressed)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (Now < NextLogTime)
+    {
+        Suppressed++;
+        return false;
+    }
+    
+    NextLogTime = Now + IntervalSeconds * FMath::Max(CVarLogRateLimitScale.GetValueOnGameThread(), 0.0f);
+    OutSuppressed = Suppressed;
+    Suppressed = 0;
+    return true;
+}
+#pragma endregion
+/*-------------------------------------------------------------------------*/
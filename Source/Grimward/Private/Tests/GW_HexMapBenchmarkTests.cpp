@@ -0,0 +1,591 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Tests/GW_TestWorld.h"
+#include "Core/ExplorationMap/GW_ExplorableHexMap.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "Blueprint/UserWidget.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Input/HittestGrid.h"
+#include "Widgets/SNullWidget.h"
+#include "Rendering/DrawElements.h"
+#include "UObject/GCObject.h"
+#include "UObject/UObjectGlobals.h"
+#include "Widgets/SVirtualWindow.h"
+#include "Grimward.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexMapBenchmarkTests.cpp
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GW_HexMapBenchmark
+{
+    /**
+     * Run settings and the limits the run is judged against. Every field can be passed as
+     * "-HexMapBenchmark.<Field>=<Value>" on the command line or as "<Field>=<Value>" in the
+     * test parameters, e.g. -HexMapBenchmark.MapClass=/Game/UI/WBP_Map.WBP_Map_C
+     */
+    struct FSettings
+    {
+        /** Hex map widget class to build; the native class has no MapCanvas, so the run is skipped without one */
+        FString MapClass;
+        
+        int32 MapSize = 2000;
+        int32 Seed = 12345;
+        
+        /** Saved/HexMapBenchmark/<Script>.csv */
+        FString Script = TEXT("Default");
+        
+        /** Size of the offscreen window the map is painted into */
+        int32 ViewportWidth = 1920;
+        int32 ViewportHeight = 1080;
+        
+        /** Frames at the start of the script left out of the verdict (first layout, pool warm-up) */
+        int32 WarmupFrames = 10;
+        
+        /** 95th percentile and worst single frame of per-frame UpdateVisibleTiles time */
+        float MaxUpdateMsP95 = 2.0f;
+        float MaxUpdateMsPeak = 8.0f;
+        
+        /** Tile widgets alive at once (spawned + pooled); only meaningful below the map's pool cap, which it never exceeds */
+        int32 MaxTileWidgets = 400;
+        
+        /** Visible hexes queued for a tile widget on any one frame */
+        int32 MaxPendingTiles = 150;
+        
+        /** Placeholder hexes summed over the measured frames, i.e. how long plain hexes stood in for tiles */
+        int32 MaxPlaceholderHexFrames = 3000;
+        
+        /** Tile widgets created after warm-up because the pool was empty */
+        int32 MaxPoolMisses = 50;
+        
+        /** Draw elements the map paints in one frame */
+        int32 MaxSlateElements = 4000;
+        
+        /** Garbage collection time summed over the measured frames */
+        float MaxTotalGCMs = 50.0f;
+        
+        void Parse(const TCHAR* Stream, const TCHAR* Prefix)
+        {
+            auto Key = [Prefix](const TCHAR* Name) { return FString::Printf(TEXT("%s%s="), Prefix, Name); };
+            
+            FParse::Value(Stream, *Key(TEXT("MapClass")), MapClass);
+            FParse::Value(Stream, *Key(TEXT("MapSize")), MapSize);
+            FParse::Value(Stream, *Key(TEXT("Seed")), Seed);
+            FParse::Value(Stream, *Key(TEXT("Script")), Script);
+            FParse::Value(Stream, *Key(TEXT("ViewportWidth")), ViewportWidth);
+            FParse::Value(Stream, *Key(TEXT("ViewportHeight")), ViewportHeight);
+            FParse::Value(Stream, *Key(TEXT("WarmupFrames")), WarmupFrames);
+            FParse::Value(Stream, *Key(TEXT("MaxUpdateMsP95")), MaxUpdateMsP95);
+            FParse::Value(Stream, *Key(TEXT("MaxUpdateMsPeak")), MaxUpdateMsPeak);
+            FParse::Value(Stream, *Key(TEXT("MaxTileWidgets")), MaxTileWidgets);
+            FParse::Value(Stream, *Key(TEXT("MaxPendingTiles")), MaxPendingTiles);
+            FParse::Value(Stream, *Key(TEXT("MaxPlaceholderHexFrames")), MaxPlaceholderHexFrames);
+            FParse::Value(Stream, *Key(TEXT("MaxPoolMisses")), MaxPoolMisses);
+            FParse::Value(Stream, *Key(TEXT("MaxSlateElements")), MaxSlateElements);
+            FParse::Value(Stream, *Key(TEXT("MaxTotalGCMs")), MaxTotalGCMs);
+        }
+    };
+    
+    /** One frame of a pan/zoom script */
+    struct FStep
+    {
+        /** Passed to PanViewport, in widget-local units */
+        FVector2D Pan = FVector2D::ZeroVector;
+        
+        /** Passed to SetZoom when positive; 0 keeps the current zoom */
+        float Zoom = 0.0f;
+    };
+    
+    /** What was measured on one frame */
+    struct FFrame
+    {
+        float PaintMs = 0.0f;
+        float UpdateMs = 0.0f;
+        int32 VisibilityUpdates = 0;
+        int32 TilesBuilt = 0;
+        int32 PoolHits = 0;
+        int32 PoolMisses = 0;
+        int32 SpawnedTiles = 0;
+        int32 PooledTiles = 0;
+        int32 PendingTiles = 0;
+        int32 PlaceholderHexes = 0;
+        int32 SlateElements = 0;
+        float GCMs = 0.0f;
+    };
+    
+    /** Fixed frame time, so the map's camera easing and tile budget behave the same on every run */
+    static constexpr float FrameDeltaSeconds = 1.0f / 60.0f;
+    
+    static FString GetBenchmarkDir()
+    {
+        return FPaths::ProjectSavedDir() / TEXT("HexMapBenchmark");
+    }
+    
+    /** Read a script; false if the file is missing or has no valid rows */
+    static bool LoadScript(const FString& FilePath, TArray<FStep>& OutSteps)
+    {
+        OutSteps.Reset();
+        
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+            return false;
+        
+        TArray<FString> Fields;
+        for (const FString& Line : Lines)
+        {
+            // Comments and the header row are anything that does not start with a number
+            Line.ParseIntoArray(Fields, TEXT(","), true);
+            if (Fields.Num() < 3 || !Fields[0].TrimStartAndEnd().IsNumeric())
+                continue;
+            
+            FStep& Step = OutSteps.AddDefaulted_GetRef();
+            Step.Pan = FVector2D(FCString::Atod(*Fields[0]), FCString::Atod(*Fields[1]));
+            Step.Zoom = FCString::Atof(*Fields[2]);
+        }
+        return OutSteps.Num() > 0;
+    }
+    
+    static void SaveScript(const FString& FilePath, const TArray<FStep>& Steps)
+    {
+        FString Text = TEXT("# One row per frame: pan passed to PanViewport, zoom passed to SetZoom (0 keeps the current zoom)\nPanX,PanY,Zoom\n");
+        for (const FStep& Step : Steps)
+        {
+            Text += FString::Printf(TEXT("%.2f,%.2f,%.3f\n"), Step.Pan.X, Step.Pan.Y, Step.Zoom);
+        }
+        FFileHelper::SaveStringToFile(Text, *FilePath);
+    }
+    
+    /** Slow pans, flings, zooming across the LOD threshold and back in to maximum zoom */
+    static void BuildDefaultScript(TArray<FStep>& OutSteps)
+    {
+        OutSteps.Reset();
+        
+        // NumFrames of a constant pan, optionally easing the zoom from ZoomFrom to ZoomTo
+        auto AddSegment = [&OutSteps](int32 NumFrames, FVector2D Pan, float ZoomFrom = 0.0f, float ZoomTo = 0.0f)
+        {
+            for (int32 i = 0; i < NumFrames; i++)
+            {
+                FStep& Step = OutSteps.AddDefaulted_GetRef();
+                Step.Pan = Pan;
+                Step.Zoom = ZoomFrom > 0.0f ? FMath::Lerp(ZoomFrom, ZoomTo, (i + 1.0f) / NumFrames) : 0.0f;
+            }
+        };
+        
+        AddSegment(10, FVector2D::ZeroVector);
+        
+        // Steady drags along each axis, then flings that outrun the prefetch margin
+        AddSegment(120, FVector2D(-40.0, 0.0));
+        AddSegment(120, FVector2D(0.0, -40.0));
+        AddSegment(60, FVector2D(-150.0, -90.0));
+        AddSegment(60, FVector2D(150.0, 0.0));
+        
+        // Out past the LOD threshold while moving, across the LOD image, and back in to full zoom
+        AddSegment(60, FVector2D(-20.0, -20.0), 1.0f, 0.5f);
+        AddSegment(60, FVector2D(-60.0, 0.0));
+        AddSegment(60, FVector2D::ZeroVector, 0.5f, 2.0f);
+        AddSegment(120, FVector2D(-30.0, 30.0));
+        
+        // Hover around the threshold so the tiles and the LOD image keep swapping
+        for (int32 i = 0; i < 4; i++)
+        {
+            AddSegment(20, FVector2D::ZeroVector, 0.9f, 0.6f);
+            AddSegment(20, FVector2D::ZeroVector, 0.6f, 0.9f);
+        }
+        
+        AddSegment(60, FVector2D::ZeroVector);
+    }
+    
+    /** Draw elements of every type in a painted element list */
+    static int32 CountDrawElements(const FSlateWindowElementList& ElementList)
+    {
+        int32 Count = 0;
+        VisitTupleElements([&Count](const auto& Elements) { Count += Elements.Num(); }, ElementList.GetUncachedDrawElements());
+        return Count;
+    }
+}
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Hex Map Benchmark                                                      */
+/*-------------------------------------------------------------------------*/
+/**
+ * Replays a pan/zoom script against a UGW_ExplorableHexMap built on a generated map in a
+ * private test world, painting it into an offscreen window once per frame. Records per frame
+ * the UpdateVisibleTiles time, tile widget counts, pool hits and misses, hexes still waiting
+ * for a tile (queued and shown as placeholders), the draw elements the map painted and
+ * garbage collection time.
+ *
+ * Scripts are CSV files in Saved/HexMapBenchmark/ with one "PanX,PanY,Zoom" row per frame;
+ * a missing script is generated and written there so it can be replaced by a recorded one.
+ * Results go to a per-run CSV next to it and one summary row per run to History.csv.
+ */
+class FGW_HexMapBenchmark : public FGCObject
+{
+public:
+    explicit FGW_HexMapBenchmark(const GW_HexMapBenchmark::FSettings& InSettings)
+        : Settings(InSettings)
+    {
+    }
+    
+    virtual ~FGW_HexMapBenchmark() override
+    {
+        TearDown();
+    }
+    
+    /** Build the world, the map and the window; false if anything is missing (an error on Test, or a warning when no map class was given) */
+    bool Start(FAutomationTestBase& Test)
+    {
+        using namespace GW_HexMapBenchmark;
+        
+        // Default perf runs pass no settings; skip rather than fail them
+        if (Settings.MapClass.IsEmpty())
+        {
+            Test.AddWarning(TEXT("HexMapBenchmark skipped: no hex map widget class; pass one with -HexMapBenchmark.MapClass=<path>"));
+            return false;
+        }
+        
+        UClass* MapClass = LoadClass<UGW_ExplorableHexMap>(nullptr, *Settings.MapClass);
+        if (!MapClass)
+        {
+            Test.AddError(FString::Printf(TEXT("Failed to load the hex map widget class '%s'"), *Settings.MapClass));
+            return false;
+        }
+        
+        if (Settings.MapSize <= 0 || Settings.ViewportWidth <= 0 || Settings.ViewportHeight <= 0)
+        {
+            Test.AddError(TEXT("Map and viewport sizes must be positive"));
+            return false;
+        }
+        
+        const FString ScriptPath = GetBenchmarkDir() / Settings.Script + TEXT(".csv");
+        if (!LoadScript(ScriptPath, Script))
+        {
+            BuildDefaultScript(Script);
+            SaveScript(ScriptPath, Script);
+            UE_LOG(LogGrimward, Log, TEXT("HexMapBenchmark: No script at %s, wrote the default one (%d frames)"), *ScriptPath, Script.Num());
+        }
+        
+        TestWorld = MakeUnique<FGW_TestWorld>();
+        
+        MapGenerator = TestWorld->World->SpawnActor<AGW_MapGenerator>();
+        MapGenerator->GenWidth = Settings.MapSize;
+        MapGenerator->GenHeight = Settings.MapSize;
+        
+        const double GenerateStartTime = FPlatformTime::Seconds();
+        MapGenerator->GenerateBiomeMap(Settings.Seed);
+        const double GenerateSeconds = FPlatformTime::Seconds() - GenerateStartTime;
+        
+        HexMap = CreateWidget<UGW_ExplorableHexMap>(TestWorld->World, MapClass);
+        if (!HexMap)
+        {
+            Test.AddError(TEXT("Failed to create the hex map widget"));
+            return false;
+        }
+        
+        const FVector2D ViewportSize(Settings.ViewportWidth, Settings.ViewportHeight);
+        Window = SNew(SVirtualWindow).Size(ViewportSize);
+        Window->SetContent(HexMap->TakeWidget());
+        
+        const double InitStartTime = FPlatformTime::Seconds();
+        HexMap->InitializeMap(MapGenerator, Settings.Seed, FIntPoint(Settings.MapSize / 2, Settings.MapSize / 2));
+        const double InitSeconds = FPlatformTime::Seconds() - InitStartTime;
+        
+        UE_LOG(LogGrimward, Log, TEXT("HexMapBenchmark: %dx%d map generated in %.1f ms, initialized in %.1f ms; replaying '%s' (%d frames)"),
+            Settings.MapSize, Settings.MapSize, GenerateSeconds * 1000.0, InitSeconds * 1000.0, *Settings.Script, Script.Num());
+        
+        // A limit at or above the cap is never reached, so that check would pass whatever the map does
+        TilePoolCap = HexMap->GetTilePoolCap();
+        if (Settings.MaxTileWidgets >= TilePoolCap)
+        {
+            Test.AddWarning(FString::Printf(TEXT("MaxTileWidgets (%d) is not below the tile pool cap (%d); the tile widget check cannot fail"),
+                Settings.MaxTileWidgets, TilePoolCap));
+        }
+        
+        // The initial full build is reported above, not as a frame
+        HexMap->ResetStats();
+        Frames.Reset();
+        Frames.Reserve(Script.Num());
+        StepIndex = 0;
+        PendingGCSeconds = 0.0;
+        
+        PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FGW_HexMapBenchmark::OnPreGarbageCollect);
+        PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FGW_HexMapBenchmark::OnPostGarbageCollect);
+        
+        RunName = FString::Printf(TEXT("%s_%dx%d_%s"), *Settings.Script, Settings.MapSize, Settings.MapSize, *FDateTime::Now().ToString());
+        return true;
+    }
+    
+    /** Apply the next step and paint one frame; true once the script has run out */
+    bool Step()
+    {
+        if (StepIndex >= Script.Num())
+            return true;
+        
+        const GW_HexMapBenchmark::FStep& Step = Script[StepIndex++];
+        if (!Step.Pan.IsZero())
+        {
+            HexMap->PanViewport(Step.Pan);
+        }
+        
+        if (Step.Zoom > 0.0f)
+        {
+            HexMap->SetZoom(Step.Zoom);
+        }
+        
+        PaintFrame();
+        return StepIndex >= Script.Num();
+    }
+    
+    /** Write the CSVs and judge the frames after warm-up against the limits, as errors on Test */
+    void Report(FAutomationTestBase& Test)
+    {
+        using namespace GW_HexMapBenchmark;
+        
+        TearDown();
+        
+        // Per-frame results, one CSV per run
+        FString Csv = TEXT("Frame,PaintMs,UpdateMs,VisibilityUpdates,TilesBuilt,PoolHits,PoolMisses,SpawnedTiles,PooledTiles,PendingTiles,PlaceholderHexes,SlateElements,GCMs\n");
+        for (int32 i = 0; i < Frames.Num(); i++)
+        {
+            const FFrame& Frame = Frames[i];
+            Csv += FString::Printf(TEXT("%d,%.3f,%.3f,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.3f\n"), i, Frame.PaintMs, Frame.UpdateMs,
+                Frame.VisibilityUpdates, Frame.TilesBuilt, Frame.PoolHits, Frame.PoolMisses,
+                Frame.SpawnedTiles, Frame.PooledTiles, Frame.PendingTiles, Frame.PlaceholderHexes, Frame.SlateElements, Frame.GCMs);
+        }
+        const FString RunPath = GetBenchmarkDir() / RunName + TEXT(".csv");
+        FFileHelper::SaveStringToFile(Csv, *RunPath);
+        
+        TArray<float> UpdateMs;
+        float TotalUpdateMs = 0.0f;
+        int32 PeakTileWidgets = 0;
+        int32 PoolMisses = 0;
+        int32 PoolHits = 0;
+        int32 PeakPendingTiles = 0;
+        int32 PlaceholderHexFrames = 0;
+        int32 PeakSlateElements = 0;
+        float TotalGCMs = 0.0f;
+        for (int32 i = FMath::Min(Settings.WarmupFrames, Frames.Num()); i < Frames.Num(); i++)
+        {
+            const FFrame& Frame = Frames[i];
+            UpdateMs.Add(Frame.UpdateMs);
+            TotalUpdateMs += Frame.UpdateMs;
+            PeakTileWidgets = FMath::Max(PeakTileWidgets, Frame.SpawnedTiles + Frame.PooledTiles);
+            PoolMisses += Frame.PoolMisses;
+            PoolHits += Frame.PoolHits;
+            PeakPendingTiles = FMath::Max(PeakPendingTiles, Frame.PendingTiles);
+            PlaceholderHexFrames += Frame.PlaceholderHexes;
+            PeakSlateElements = FMath::Max(PeakSlateElements, Frame.SlateElements);
+            TotalGCMs += Frame.GCMs;
+        }
+        
+        if (UpdateMs.Num() == 0)
+        {
+            Test.AddError(TEXT("No frames measured after warm-up; nothing to judge"));
+            return;
+        }
+        
+        UpdateMs.Sort();
+        const float P95Ms = UpdateMs[FMath::Min(UpdateMs.Num() - 1, FMath::FloorToInt32(UpdateMs.Num() * 0.95f))];
+        const float PeakMs = UpdateMs.Last();
+        const float AverageMs = TotalUpdateMs / UpdateMs.Num();
+        
+        bool bPassed = true;
+        auto Check = [&Test, &bPassed](const TCHAR* Name, double Value, double Limit)
+        {
+            const bool bOk = Value <= Limit;
+            bPassed &= bOk;
+            UE_LOG(LogGrimward, Display, TEXT("HexMapBenchmark:   %-28s %10.3f  (limit %.3f)  %s"), Name, Value, Limit, bOk ? TEXT("ok") : TEXT("FAILED"));
+            if (!bOk)
+            {
+                Test.AddError(FString::Printf(TEXT("%s: %.3f exceeds the limit of %.3f"), Name, Value, Limit));
+            }
+        };
+        
+        UE_LOG(LogGrimward, Display, TEXT("HexMapBenchmark: %s, %d frames measured (avg update %.3f ms, %d pool hits, tile pool cap %d)"),
+            *RunName, UpdateMs.Num(), AverageMs, PoolHits, TilePoolCap);
+        Check(TEXT("UpdateVisibleTiles p95 ms"), P95Ms, Settings.MaxUpdateMsP95);
+        Check(TEXT("UpdateVisibleTiles peak ms"), PeakMs, Settings.MaxUpdateMsPeak);
+        Check(TEXT("Tile widgets (peak)"), PeakTileWidgets, Settings.MaxTileWidgets);
+        Check(TEXT("Pool misses"), PoolMisses, Settings.MaxPoolMisses);
+        Check(TEXT("Pending tiles (peak)"), PeakPendingTiles, Settings.MaxPendingTiles);
+        Check(TEXT("Placeholder hex-frames (total)"), PlaceholderHexFrames, Settings.MaxPlaceholderHexFrames);
+        Check(TEXT("Slate draw elements (peak)"), PeakSlateElements, Settings.MaxSlateElements);
+        Check(TEXT("GC ms (total)"), TotalGCMs, Settings.MaxTotalGCMs);
+        UE_LOG(LogGrimward, Display, TEXT("HexMapBenchmark: %s, frames written to %s"), bPassed ? TEXT("PASSED") : TEXT("FAILED"), *RunPath);
+        
+        // One summary row per run, so numbers can be compared across changes
+        const FString HistoryPath = GetBenchmarkDir() / TEXT("History.csv");
+        FString HistoryRow;
+        if (!IFileManager::Get().FileExists(*HistoryPath))
+        {
+            HistoryRow = TEXT("Run,Frames,AvgUpdateMs,P95UpdateMs,PeakUpdateMs,PeakTileWidgets,PoolHits,PoolMisses,PeakPendingTiles,PlaceholderHexFrames,PeakSlateElements,TotalGCMs,Passed\n");
+        }
+        HistoryRow += FString::Printf(TEXT("%s,%d,%.3f,%.3f,%.3f,%d,%d,%d,%d,%d,%d,%.3f,%d\n"), *RunName, UpdateMs.Num(), AverageMs, P95Ms, PeakMs,
+            PeakTileWidgets, PoolHits, PoolMisses, PeakPendingTiles, PlaceholderHexFrames, PeakSlateElements, TotalGCMs, bPassed ? 1 : 0);
+        FFileHelper::SaveStringToFile(HistoryRow, *HistoryPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+    }
+    
+    // FGCObject
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+    {
+        Collector.AddReferencedObject(MapGenerator);
+        Collector.AddReferencedObject(HexMap);
+    }
+    
+    virtual FString GetReferencerName() const override
+    {
+        return TEXT("FGW_HexMapBenchmark");
+    }
+
+private:
+    /** Lay out, tick and paint the window the way a viewport would, then record what the map did */
+    void PaintFrame()
+    {
+        const double PaintStartTime = FPlatformTime::Seconds();
+        
+        Window->SlatePrepass(1.0f);
+        
+        // Widgets tick as part of painting, so this runs the map's NativeTick and visibility update
+        FSlateWindowElementList ElementList(Window);
+        const FGeometry WindowGeometry = FGeometry::MakeRoot(Window->GetSizeInScreen(), FSlateLayoutTransform());
+        const FSlateRect ClipRect = WindowGeometry.GetLayoutBoundingRect();
+        Window->GetHittestGrid().SetHittestArea(FVector2D::ZeroVector, WindowGeometry.GetLocalSize());
+        FPaintArgs PaintArgs(nullptr, Window->GetHittestGrid(), FVector2D::ZeroVector, FApp::GetCurrentTime(), GW_HexMapBenchmark::FrameDeltaSeconds);
+        Window->Paint(PaintArgs, WindowGeometry, ClipRect, ElementList, 0, FWidgetStyle(), true);
+        
+        const double PaintSeconds = FPlatformTime::Seconds() - PaintStartTime;
+        const FGW_HexMapStats& Stats = HexMap->GetStats();
+        
+        GW_HexMapBenchmark::FFrame& Frame = Frames.AddDefaulted_GetRef();
+        Frame.PaintMs = (float)(PaintSeconds * 1000.0);
+        Frame.UpdateMs = (float)(Stats.VisibilityUpdateSeconds * 1000.0);
+        Frame.VisibilityUpdates = Stats.VisibilityUpdates;
+        Frame.TilesBuilt = Stats.TilesBuilt;
+        Frame.PoolHits = Stats.PoolHits;
+        Frame.PoolMisses = Stats.PoolMisses;
+        Frame.SpawnedTiles = HexMap->GetSpawnedTileCount();
+        Frame.PooledTiles = HexMap->GetPooledTileCount();
+        Frame.PendingTiles = HexMap->GetPendingTileCount();
+        Frame.PlaceholderHexes = HexMap->GetPlaceholderHexCount();
+        Frame.SlateElements = GW_HexMapBenchmark::CountDrawElements(ElementList);
+        Frame.GCMs = (float)(PendingGCSeconds * 1000.0);
+        
+        HexMap->ResetStats();
+        PendingGCSeconds = 0.0;
+    }
+    
+    void OnPreGarbageCollect()
+    {
+        GCStartTime = FPlatformTime::Seconds();
+    }
+    
+    void OnPostGarbageCollect()
+    {
+        if (GCStartTime > 0.0)
+        {
+            PendingGCSeconds += FPlatformTime::Seconds() - GCStartTime;
+            GCStartTime = 0.0;
+        }
+    }
+    
+    /** Drop the window, the map and the test world; the world's subsystems go with it */
+    void TearDown()
+    {
+        FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+        FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+        PreGCHandle.Reset();
+        PostGCHandle.Reset();
+        
+        if (Window.IsValid())
+        {
+            Window->SetContent(SNullWidget::NullWidget);
+            Window.Reset();
+        }
+        
+        HexMap = nullptr;
+        MapGenerator = nullptr;
+        TestWorld.Reset();
+    }
+    
+    GW_HexMapBenchmark::FSettings Settings;
+    
+    TUniquePtr<FGW_TestWorld> TestWorld;
+    TObjectPtr<AGW_MapGenerator> MapGenerator = nullptr;
+    TObjectPtr<UGW_ExplorableHexMap> HexMap = nullptr;
+    TSharedPtr<SVirtualWindow> Window;
+    
+    FString RunName;
+    int32 TilePoolCap = 0;
+    TArray<GW_HexMapBenchmark::FStep> Script;
+    TArray<GW_HexMapBenchmark::FFrame> Frames;
+    int32 StepIndex = 0;
+    
+    // Garbage collection time since the last sample
+    double GCStartTime = 0.0;
+    double PendingGCSeconds = 0.0;
+    FDelegateHandle PreGCHandle;
+    FDelegateHandle PostGCHandle;
+};
+
+/** Paints one benchmark frame per engine frame and reports when the script is done */
+class FGW_RunHexMapBenchmarkCommand : public IAutomationLatentCommand
+{
+public:
+    FGW_RunHexMapBenchmarkCommand(FAutomationTestBase& InTest, const TSharedRef<FGW_HexMapBenchmark>& InBenchmark)
+        : Test(InTest)
+        , Benchmark(InBenchmark)
+    {
+    }
+    
+    virtual bool Update() override
+    {
+        if (!Benchmark->Step())
+            return false;
+        
+        Benchmark->Report(Test);
+        return true;
+    }
+
+private:
+    FAutomationTestBase& Test;
+    TSharedRef<FGW_HexMapBenchmark> Benchmark;
+};
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Tests                                                                  */
+/*-------------------------------------------------------------------------*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGW_HexMapBenchmarkTest, "Grimward.ExplorationMap.Benchmark.PanZoomReplay",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FGW_HexMapBenchmarkTest::RunTest(const FString& Parameters)
+{
+    // Command line first, so parameters passed to this run win
+    GW_HexMapBenchmark::FSettings Settings;
+    Settings.Parse(FCommandLine::Get(), TEXT("-HexMapBenchmark."));
+    Settings.Parse(*Parameters, TEXT(""));
+    
+    const TSharedRef<FGW_HexMapBenchmark> Benchmark = MakeShared<FGW_HexMapBenchmark>(Settings);
+    if (!Benchmark->Start(*this))
+        return !HasAnyErrors();
+    
+    ADD_LATENT_AUTOMATION_COMMAND(FGW_RunHexMapBenchmarkCommand(*this, Benchmark));
+    return true;
+}
+
+#endif
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,144 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Tests/GW_TestWorld.h"
+#include "Core/ExplorationMap/GW_HexPathfinder.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Core/ExplorationMap/GW_HexMath.h"
+#include "Misc/AutomationTest.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Tests                                                                  */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexPathfinderTests.cpp
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGW_HexPathfinderRouteTest, "Grimward.ExplorationMap.Pathfinder.Routes",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGW_HexPathfinderRouteTest::RunTest(const FString& Parameters)
+{
+    // A great peak wall down column 6 with a single gap; the default rules make peaks impassable
+    const int32 WallColumn = 6;
+    const FIntPoint Gap(WallColumn, 6);
+    const FIntPoint Start(2, 2);
+    const FIntPoint Goal(10, 2);
+    
+    FGW_TestWorld TestWorld;
+    AGW_MapGenerator* Generator = TestWorld.SpawnGridGenerator(12, 8, EGW_HexBiome::Hill,
+        [Gap](FIntPoint GridPos, FGW_BiomeData& Data)
+        {
+            if (GridPos.X == Gap.X && GridPos != Gap)
+            {
+                Data.BiomeEntry = EGW_HexBiome::GreatPeak;
+            }
+        });
+    
+    UGW_HexWorldState* WorldState = TestWorld.GetSubsystem<UGW_HexWorldState>();
+    UGW_HexPathfinder* Pathfinder = TestWorld.GetSubsystem<UGW_HexPathfinder>();
+    if (!TestNotNull(TEXT("HexWorldState"), WorldState) || !TestNotNull(TEXT("HexPathfinder"), Pathfinder))
+        return false;
+    
+    // The pathfinder sizes its cost grid from the bound map
+    WorldState->BindMap(Generator);
+    
+    TestEqual(TEXT("Hills cost their rule"), Pathfinder->GetTravelCost(Start), 2);
+    TestEqual(TEXT("Peaks are impassable"), Pathfinder->GetTravelCost(FIntPoint(WallColumn, 2)), -1);
+    
+    TArray<FIntPoint> Path;
+    int32 Cost = 0;
+    if (!TestTrue(TEXT("A route through the gap is found"), Pathfinder->FindPath(Start, Goal, Path, Cost)))
+        return false;
+    
+    TestEqual(TEXT("The route starts at the start"), Path[0], Start);
+    TestEqual(TEXT("The route ends at the goal"), Path.Last(), Goal);
+    TestTrue(TEXT("The route passes the gap"), Path.Contains(Gap));
+    
+    // Every step is to a neighbour, and the cost is what entering each hex after the start costs
+    int32 SummedCost = 0;
+    for (int32 i = 1; i < Path.Num(); i++)
+    {
+        TestEqual(TEXT("Steps are one hex apart"), GW_HexMath::Distance(Path[i - 1], Path[i]), 1);
+        SummedCost += Pathfinder->GetTravelCost(Path[i]);
+    }
+    TestEqual(TEXT("The route cost is the sum of its entry costs"), Cost, SummedCost);
+    
+    // Only hills on this map, so the cheapest route is also the shortest one through the gap
+    const int32 ShortestSteps = GW_HexMath::Distance(Start, Gap) + GW_HexMath::Distance(Gap, Goal);
+    TestEqual(TEXT("The route is the shortest one"), Path.Num() - 1, ShortestSteps);
+    
+    // Closing the gap by keeping it hidden leaves no route
+    FGW_HexTravelRules Rules;
+    Rules.bCanEnterHidden = false;
+    Pathfinder->SetTravelRules(Rules);
+    WorldState->RevealHexRange(Start, 12);
+    WorldState->SetTileState(Gap, EGW_HexTileState::Hidden);
+    
+    TestFalse(TEXT("No route through a hidden gap"), Pathfinder->FindPath(Start, Goal, Path, Cost));
+    TestEqual(TEXT("A failed search returns no route"), Path.Num(), 0);
+    
+    WorldState->SetTileState(Gap, EGW_HexTileState::Explored);
+    TestTrue(TEXT("Exploring the gap opens the route again"), Pathfinder->FindPath(Start, Goal, Path, Cost));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGW_HexPathfinderDistanceMapTest, "Grimward.ExplorationMap.Pathfinder.DistanceMaps",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGW_HexPathfinderDistanceMapTest::RunTest(const FString& Parameters)
+{
+    const FIntPoint Source(7, 7);
+    const GW_HexMath::FAxial Center = GW_HexMath::ToAxial(Source);
+    auto RingOneIt = GW_HexMath::FRing(Center, 1).begin();
+    const FIntPoint RingOne = GW_HexMath::ToOffset(*RingOneIt);
+    const FIntPoint RingOneNext = GW_HexMath::ToOffset(*++RingOneIt);
+    const FIntPoint RingTwo = GW_HexMath::ToOffset(*GW_HexMath::FRing(Center, 2).begin());
+    const FIntPoint RingThree = GW_HexMath::ToOffset(*GW_HexMath::FRing(Center, 3).begin());
+    
+    FGW_TestWorld TestWorld;
+    AGW_MapGenerator* Generator = TestWorld.SpawnGridGenerator(15, 15, EGW_HexBiome::Hill,
+        [](FIntPoint GridPos, FGW_BiomeData& Data) {});
+    
+    UGW_HexWorldState* WorldState = TestWorld.GetSubsystem<UGW_HexWorldState>();
+    UGW_HexPathfinder* Pathfinder = TestWorld.GetSubsystem<UGW_HexPathfinder>();
+    if (!TestNotNull(TEXT("HexWorldState"), WorldState) || !TestNotNull(TEXT("HexPathfinder"), Pathfinder))
+        return false;
+    
+    WorldState->BindMap(Generator);
+    
+    // Hidden hexes must be explored first, so a later hide shows up in the costs
+    FGW_HexTravelRules Rules;
+    Rules.bCanEnterHidden = false;
+    Pathfinder->SetTravelRules(Rules);
+    WorldState->RevealHexRange(Source, 10);
+    
+    // Hills cost 2, so a budget of 4 reaches the first two rings
+    const TArray<FIntPoint> Sources = { Source };
+    const FGW_HexDistanceMap& Map = Pathfinder->GetDistanceMap(Sources, 4);
+    TestEqual(TEXT("The source costs nothing"), Map.GetCost(Source), 0);
+    TestEqual(TEXT("Ring 1 costs one step"), Map.GetCost(RingOne), 2);
+    TestEqual(TEXT("Ring 2 costs two steps"), Map.GetCost(RingTwo), 4);
+    TestFalse(TEXT("Ring 3 is over the budget"), Map.IsReachable(RingThree));
+    
+    TestTrue(TEXT("The same query is served from the cache"), &Pathfinder->GetDistanceMap(Sources, 4) == &Map);
+    
+    TArray<FIntPoint> Reachable;
+    TestEqual(TEXT("Both rings and the source are reachable"), Pathfinder->GetReachableHexes(Sources, 4, Reachable), 1 + 6 + 12);
+    
+    // A change outside the map's bounds does not touch the reach
+    WorldState->SetTileState(FIntPoint(14, 0), EGW_HexTileState::Hidden);
+    TestEqual(TEXT("A distant change leaves the reach alone"), Pathfinder->GetDistanceMap(Sources, 4).GetCost(RingOne), 2);
+    
+    // Hiding a ring 1 hex inside the bounds rebuilds the map without it
+    WorldState->SetTileState(RingOne, EGW_HexTileState::Hidden);
+    const FGW_HexDistanceMap& Rebuilt = Pathfinder->GetDistanceMap(Sources, 4);
+    TestFalse(TEXT("A hidden hex drops out of the reach"), Rebuilt.IsReachable(RingOne));
+    TestEqual(TEXT("The rest of ring 1 is unchanged"), Rebuilt.GetCost(RingOneNext), 2);
+    return true;
+}
+
+#endif
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,58 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Tests/GW_TestWorld.h"
+#include "Core/ExplorationMap/GW_HexRevealService.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Core/ExplorationMap/GW_HexMath.h"
+#include "Misc/AutomationTest.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Tests                                                                  */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexRevealServiceTests.cpp
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGW_HexRevealRingStartShadowTest, "Grimward.ExplorationMap.Reveal.OccluderAtRingStartCorner",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGW_HexRevealRingStartShadowTest::RunTest(const FString& Parameters)
+{
+    // Ring arcs are measured from the start corner, so the hex there has a shadow straddling angle 0
+    const FIntPoint Origin(10, 10);
+    const GW_HexMath::FAxial Center = GW_HexMath::ToAxial(Origin);
+    const FIntPoint Blocker = GW_HexMath::ToOffset(*GW_HexMath::FRing(Center, 1).begin());
+    const FIntPoint Behind = GW_HexMath::ToOffset(*GW_HexMath::FRing(Center, 2).begin());
+    
+    FGW_TestWorld TestWorld;
+    AGW_MapGenerator* Generator = TestWorld.SpawnGridGenerator(21, 21, EGW_HexBiome::Hill,
+        [Blocker](FIntPoint GridPos, FGW_BiomeData& Data)
+        {
+            if (GridPos == Blocker)
+            {
+                Data.BiomeEntry = EGW_HexBiome::Mountain;
+            }
+        });
+    
+    UGW_HexWorldState* WorldState = TestWorld.GetSubsystem<UGW_HexWorldState>();
+    UGW_HexRevealService* RevealService = TestWorld.GetSubsystem<UGW_HexRevealService>();
+    if (!TestNotNull(TEXT("HexWorldState"), WorldState) || !TestNotNull(TEXT("HexRevealService"), RevealService))
+        return false;
+    
+    // The reveal service picks the occluders up from the bound map
+    WorldState->BindMap(Generator);
+    
+    TArray<FIntPoint> Visible;
+    RevealService->ComputeFieldOfView(Origin, 2, Visible);
+    
+    TestTrue(TEXT("The mountain at ring 1, index 0 is seen"), Visible.Contains(Blocker));
+    TestFalse(TEXT("The hex behind it at ring 2, index 0 is hidden"), Visible.Contains(Behind));
+    TestFalse(TEXT("No line of sight past the mountain"), RevealService->HasLineOfSight(Origin, Behind));
+    return true;
+}
+
+#endif
+#pragma endregion
+/*-------------------------------------------------------------------------*/
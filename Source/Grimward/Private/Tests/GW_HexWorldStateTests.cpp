@@ -0,0 +1,121 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Tests/GW_TestWorld.h"
+#include "Core/ExplorationMap/GW_HexWorldState.h"
+#include "Core/GW_SaveGame.h"
+#include "Misc/AutomationTest.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Tests                                                                  */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexWorldStateTests.cpp
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGW_HexExplorationSaveTest, "Grimward.ExplorationMap.WorldState.ExplorationSave",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGW_HexExplorationSaveTest::RunTest(const FString& Parameters)
+{
+    FGW_TestWorld TestWorld;
+    AGW_MapGenerator* Generator = TestWorld.SpawnGridGenerator(40, 3, EGW_HexBiome::Hill, [](FIntPoint, FGW_BiomeData&) {});
+    
+    UGW_HexWorldState* WorldState = TestWorld.GetSubsystem<UGW_HexWorldState>();
+    if (!TestNotNull(TEXT("HexWorldState"), WorldState))
+        return false;
+    
+    WorldState->BindMap(Generator);
+    
+    // Row 0 is a few long runs, row 1 alternates every hex so it is written packed, row 2 stays hidden
+    for (int32 X = 5; X < 25; X++)
+    {
+        WorldState->SetTileState(FIntPoint(X, 0), EGW_HexTileState::Explored);
+    }
+    for (int32 X = 0; X < 40; X++)
+    {
+        WorldState->SetTileState(FIntPoint(X, 1), (EGW_HexTileState)(X % 3));
+    }
+    
+    FGW_ExplorationSaveData Saved;
+    WorldState->ExportExploration(Saved);
+    
+    TArray<EGW_HexTileState> Expected;
+    Expected.SetNumUninitialized(40 * 3);
+    WorldState->GetTileStatesInRect(FIntRect(0, 0, 40, 3), Expected);
+    
+    auto StatesMatch = [WorldState, &Expected]()
+    {
+        TArray<EGW_HexTileState> States;
+        States.SetNumUninitialized(Expected.Num());
+        WorldState->GetTileStatesInRect(FIntRect(0, 0, 40, 3), States);
+        return States == Expected;
+    };
+    
+    WorldState->ResetExploration(40, 3);
+    TestTrue(TEXT("A saved exploration imports onto the same map"), WorldState->ImportExploration(Saved));
+    TestTrue(TEXT("Every tile state survives the round trip"), StatesMatch());
+    
+    // Rejected data must leave the store untouched
+    FGW_ExplorationSaveData Trailing = Saved;
+    Trailing.TileStates.Add(0);
+    TestFalse(TEXT("Bytes after the last row are rejected"), WorldState->ImportExploration(Trailing));
+    
+    FGW_ExplorationSaveData UnknownMode = Saved;
+    UnknownMode.TileStates[0] = 7;
+    TestFalse(TEXT("An unknown row mode is rejected"), WorldState->ImportExploration(UnknownMode));
+    
+    // Row 0 is its mode byte and three one-byte runs, so row 1 (packed) starts at byte 4;
+    // the byte after its mode holds hexes 0-3, and 3 is not a tile state
+    FGW_ExplorationSaveData BadState = Saved;
+    const int32 PackedRow = 4;
+    TestEqual(TEXT("Row 1 is written packed"), (int32)BadState.TileStates[PackedRow], 1);
+    BadState.TileStates[PackedRow + 1] |= 3;
+    TestFalse(TEXT("A packed tile state of 3 is rejected"), WorldState->ImportExploration(BadState));
+    
+    FGW_ExplorationSaveData OtherMap = Saved;
+    OtherMap.Params.Seed++;
+    TestFalse(TEXT("A save for other generation params is rejected"), WorldState->ImportExploration(OtherMap));
+    
+    FGW_ExplorationSaveData OtherSettings = Saved;
+    OtherSettings.GeneratorSettingsHash++;
+    TestFalse(TEXT("A save from other generator settings is rejected"), WorldState->ImportExploration(OtherSettings));
+    
+    TestTrue(TEXT("Rejected imports change nothing"), StatesMatch());
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGW_HexRevealMaskBoundsTest, "Grimward.ExplorationMap.WorldState.RevealMaskBounds",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGW_HexRevealMaskBoundsTest::RunTest(const FString& Parameters)
+{
+    FGW_TestWorld TestWorld;
+    AGW_MapGenerator* Generator = TestWorld.SpawnGridGenerator(40, 3, EGW_HexBiome::Hill, [](FIntPoint, FGW_BiomeData&) {});
+    
+    UGW_HexWorldState* WorldState = TestWorld.GetSubsystem<UGW_HexWorldState>();
+    if (!TestNotNull(TEXT("HexWorldState"), WorldState))
+        return false;
+    
+    WorldState->BindMap(Generator);
+    
+    // Reaches past the right and bottom edges, so its words do not line up with the map's chunks
+    FGW_HexRevealMask Unclipped;
+    Unclipped.Init(FIntRect(30, 1, 70, 5));
+    Unclipped.Add(FIntPoint(35, 1));
+    Unclipped.Add(FIntPoint(65, 4));
+    WorldState->Reveal(Unclipped);
+    TestEqual(TEXT("A mask reaching off the map is ignored"), WorldState->GetTileState(FIntPoint(35, 1)), EGW_HexTileState::Hidden);
+    
+    FGW_HexRevealMask Clipped;
+    Clipped.Init(WorldState->ClipRectToMap(FIntRect(30, 1, 70, 5)));
+    Clipped.Add(FIntPoint(35, 1));
+    WorldState->Reveal(Clipped);
+    TestEqual(TEXT("The same mask clipped to the map reveals"), WorldState->GetTileState(FIntPoint(35, 1)), EGW_HexTileState::Explored);
+    return true;
+}
+
+#endif
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,75 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "Tests/GW_TestWorld.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "Misc/AutomationTest.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Tests                                                                  */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_MapGeneratorTests.cpp
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGW_MapGeneratorPOICoverageTest, "Grimward.ExplorationMap.Generator.POICoverage",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGW_MapGeneratorPOICoverageTest::RunTest(const FString& Parameters)
+{
+    // Much taller than wide, so rows far past the width are sampled too
+    FGW_TestWorld TestWorld;
+    AGW_MapGenerator* Generator = TestWorld.World->SpawnActor<AGW_MapGenerator>();
+    Generator->GenWidth = 48;
+    Generator->GenHeight = 300;
+    Generator->GenerateBiomeMap(12345);
+    
+    const TArray<FGW_BiomeData>& BiomeMap = Generator->GetBiomeMap();
+    if (!TestEqual(TEXT("Biome map size"), BiomeMap.Num(), Generator->GenWidth * Generator->GenHeight))
+        return false;
+    
+    TArray<FVector2f> POISamples;
+    for (const FIntPoint& Pos : Generator->GetPOILocations())
+    {
+        POISamples.Add(AGW_MapGenerator::GetHexSamplePosition(Pos.X, Pos.Y));
+    }
+    
+    // Poisson-disk sampling is maximal: a hex that can hold a POI either got one or was
+    // rejected for lying within POIMaxSpacing of one, wherever it is on the map
+    const float MaxSpacingSquared = FMath::Square(Generator->POIMaxSpacing);
+    int32 Uncovered = 0;
+    FIntPoint FirstUncovered(INDEX_NONE, INDEX_NONE);
+    for (int32 Y = 0; Y < Generator->GenHeight; Y++)
+    {
+        for (int32 X = 0; X < Generator->GenWidth; X++)
+        {
+            // Water has no POI weights and rivers are carved after the biome roll
+            const EGW_HexBiome Biome = BiomeMap[Y * Generator->GenWidth + X].BiomeEntry;
+            if (Biome == EGW_HexBiome::Water || Biome == EGW_HexBiome::River)
+                continue;
+            
+            const FVector2f SamplePos = AGW_MapGenerator::GetHexSamplePosition(X, Y);
+            const bool bCovered = POISamples.ContainsByPredicate([&SamplePos, MaxSpacingSquared](const FVector2f& POI)
+            {
+                return FVector2f::DistSquared(SamplePos, POI) <= MaxSpacingSquared;
+            });
+            
+            if (!bCovered && Uncovered++ == 0)
+            {
+                FirstUncovered = FIntPoint(X, Y);
+            }
+        }
+    }
+    
+    if (Uncovered > 0)
+    {
+        AddError(FString::Printf(TEXT("%d land hexes have no POI within POIMaxSpacing, the first at (%d, %d)"),
+            Uncovered, FirstUncovered.X, FirstUncovered.Y));
+    }
+    return true;
+}
+
+#endif
+#pragma endregion
+/*-------------------------------------------------------------------------*/
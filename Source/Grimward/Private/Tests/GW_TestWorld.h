@@ -0,0 +1,82 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "Serialization/MemoryWriter.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Test World                                                             */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_TestWorld.h
+#if WITH_DEV_AUTOMATION_TESTS
+/**
+ * Private game world for automation tests, so tests get their own world subsystems
+ * (UGW_HexWorldState, UGW_HexPathfinder, ...) and never touch the world being played.
+ */
+struct FGW_TestWorld
+{
+    UWorld* World = nullptr;
+    
+    FGW_TestWorld()
+    {
+        World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GW_TestWorld"));
+        FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+        Context.SetCurrentWorld(World);
+        
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+    }
+    
+    ~FGW_TestWorld()
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    }
+    
+    FGW_TestWorld(const FGW_TestWorld&) = delete;
+    FGW_TestWorld& operator=(const FGW_TestWorld&) = delete;
+    
+    template<typename SubsystemType>
+    SubsystemType* GetSubsystem() const
+    {
+        return World->GetSubsystem<SubsystemType>();
+    }
+    
+    /** A generator holding a Width x Height grid of Fill, with Overrides(GridPos) deciding single hexes */
+    template<typename OverrideFuncType>
+    AGW_MapGenerator* SpawnGridGenerator(int32 Width, int32 Height, EGW_HexBiome Fill, OverrideFuncType&& Overrides)
+    {
+        AGW_MapGenerator* Generator = World->SpawnActor<AGW_MapGenerator>();
+        
+        // Same layout ExportGridSnapshot writes
+        TArray<uint8> Bytes;
+        FMemoryWriter Writer(Bytes);
+        int32 NumTiles = Width * Height;
+        int32 NumPOIs = 0;
+        int32 GridSeed = 0;
+        Writer << Width << Height << GridSeed << NumTiles << NumPOIs;
+        
+        for (int32 Y = 0; Y < Height; Y++)
+        {
+            for (int32 X = 0; X < Width; X++)
+            {
+                FGW_BiomeData Data = FGW_BiomeData();
+                Data.BiomeEntry = Fill;
+                Overrides(FIntPoint(X, Y), Data);
+                Writer.Serialize(&Data, sizeof(FGW_BiomeData));
+            }
+        }
+        
+        Generator->ImportGridSnapshot(Bytes);
+        return Generator;
+    }
+};
+#endif
+#pragma endregion
+/*-------------------------------------------------------------------------*/
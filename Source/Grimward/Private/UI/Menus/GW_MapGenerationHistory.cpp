@@ -0,0 +1,201 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#include "UI/Menus/GW_MapGenerationHistory.h"
+#include "Engine/Texture2D.h"
+#include "Misc/Compression.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Functions                                                              */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_MapGenerationHistory.cpp
+int64 FGW_MapHistoryEntry::GetMemorySize() const
+{
+    int64 Size = GridBytes.GetAllocatedSize();
+    if (Texture)
+    {
+        Size += int64(Texture->GetSizeX()) * Texture->GetSizeY() * sizeof(FColor);
+    }
+    return Size;
+}
+
+bool UGW_MapGenerationHistory::Restore(const FGW_MapGenerationParams& Params, AGW_MapGenerator* Generator, UTexture2D*& OutTexture)
+{
+    FGW_MapHistoryEntry* Entry = FindEntry(Params);
+    if (!Entry || !Generator)
+    {
+        return false;
+    }
+    
+    if (Entry->bCompressed)
+    {
+        TArray<uint8> RawBytes;
+        if (!DecompressEntry(*Entry, RawBytes) || !Generator->ImportGridSnapshot(RawBytes))
+        {
+            return false;
+        }
+        
+        // Make the entry hot again
+        Entry->GridBytes = MoveTemp(RawBytes);
+        Entry->bCompressed = false;
+    }
+    else if (!Generator->ImportGridSnapshot(Entry->GridBytes))
+    {
+        return false;
+    }
+    
+    Generator->ApplyGenerationParams(Entry->Params);
+    
+    if (!Entry->Texture)
+    {
+        Entry->Texture = Generator->BuildBiomeTexture();
+    }
+    
+    Entry->LastUsed = ++UseCounter;
+    OutTexture = Entry->Texture;
+    
+    EnforceBudget(Params);
+    return OutTexture != nullptr;
+}
+
+void UGW_MapGenerationHistory::Store(const FGW_MapGenerationParams& Params, const AGW_MapGenerator* Generator, UTexture2D* Texture)
+{
+    if (!Generator)
+    {
+        return;
+    }
+    
+    FGW_MapHistoryEntry* Entry = FindEntry(Params);
+    if (!Entry)
+    {
+        Entry = &Entries.AddDefaulted_GetRef();
+    }
+    
+    Entry->Params = Params;
+    Entry->ParamHash = GetTypeHash(Params);
+    Entry->Texture = Texture;
+    Entry->bCompressed = false;
+    Entry->LastUsed = ++UseCounter;
+    Generator->ExportGridSnapshot(Entry->GridBytes);
+    Entry->RawGridSize = Entry->GridBytes.Num();
+    
+    EnforceBudget(Params);
+}
+
+int64 UGW_MapGenerationHistory::GetMemoryUsage() const
+{
+    int64 Total = 0;
+    for (const FGW_MapHistoryEntry& Entry : Entries)
+    {
+        Total += Entry.GetMemorySize();
+    }
+    return Total;
+}
+
+void UGW_MapGenerationHistory::PushTimeline(const FGW_MapGenerationParams& Params)
+{
+    // Regenerating the step we are already on is not a new step
+    if (Timeline.IsValidIndex(TimelineIndex) && Timeline[TimelineIndex] == Params)
+    {
+        return;
+    }
+    
+    Timeline.SetNum(TimelineIndex + 1);
+    Timeline.Add(Params);
+    
+    if (Timeline.Num() > MaxTimelineLength)
+    {
+        Timeline.RemoveAt(0, Timeline.Num() - MaxTimelineLength);
+    }
+    TimelineIndex = Timeline.Num() - 1;
+}
+
+bool UGW_MapGenerationHistory::Undo(FGW_MapGenerationParams& OutParams)
+{
+    if (!CanUndo())
+    {
+        return false;
+    }
+    
+    OutParams = Timeline[--TimelineIndex];
+    return true;
+}
+
+bool UGW_MapGenerationHistory::Redo(FGW_MapGenerationParams& OutParams)
+{
+    if (!CanRedo())
+    {
+        return false;
+    }
+    
+    OutParams = Timeline[++TimelineIndex];
+    return true;
+}
+
+FGW_MapHistoryEntry* UGW_MapGenerationHistory::FindEntry(const FGW_MapGenerationParams& Params)
+{
+    const uint32 ParamHash = GetTypeHash(Params);
+    return Entries.FindByPredicate([ParamHash, &Params](const FGW_MapHistoryEntry& Entry)
+    {
+        return Entry.ParamHash == ParamHash && Entry.Params == Params;
+    });
+}
+
+void UGW_MapGenerationHistory::EnforceBudget(const FGW_MapGenerationParams& Keep)
+{
+    const uint32 KeepHash = GetTypeHash(Keep);
+    
+    // Most recently used first
+    Entries.Sort([](const FGW_MapHistoryEntry& A, const FGW_MapHistoryEntry& B)
+    {
+        return A.LastUsed > B.LastUsed;
+    });
+    
+    // Older entries drop their texture and keep a compressed grid
+    for (int32 i = FMath::Max(1, MaxHotEntries); i < Entries.Num(); i++)
+    {
+        if (!Entries[i].bCompressed)
+        {
+            CompressEntry(Entries[i]);
+        }
+    }
+    
+    // Evict from the least recently used end, never the entry being shown
+    int64 Usage = GetMemoryUsage();
+    for (int32 i = Entries.Num() - 1; i >= 0 && Usage > MemoryBudgetBytes; i--)
+    {
+        if (Entries[i].ParamHash != KeepHash || Entries[i].Params != Keep)
+        {
+            Usage -= Entries[i].GetMemorySize();
+            Entries.RemoveAt(i);
+        }
+    }
+}
+
+void UGW_MapGenerationHistory::CompressEntry(FGW_MapHistoryEntry& Entry)
+{
+    const int32 RawSize = Entry.GridBytes.Num();
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, RawSize);
+    
+    TArray<uint8> Compressed;
+    Compressed.SetNumUninitialized(CompressedSize);
+    if (FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Entry.GridBytes.GetData(), RawSize))
+    {
+        Compressed.SetNum(CompressedSize);
+        Entry.GridBytes = MoveTemp(Compressed);
+        Entry.RawGridSize = RawSize;
+        Entry.bCompressed = true;
+    }
+    
+    Entry.Texture = nullptr;
+}
+
+bool UGW_MapGenerationHistory::DecompressEntry(const FGW_MapHistoryEntry& Entry, TArray<uint8>& OutRawBytes)
+{
+    OutRawBytes.SetNumUninitialized(Entry.RawGridSize);
+    return FCompression::UncompressMemory(NAME_Zlib, OutRawBytes.GetData(), Entry.RawGridSize, Entry.GridBytes.GetData(), Entry.GridBytes.Num());
+}
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -7,6 +7,7 @@
 #include "Components/Image.h"
 #include "Components/EditableTextBox.h"
 #include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "UI/Menus/GW_MapGenerationHistory.h"
 #include "Engine/Texture2D.h"
 #include "Kismet/GameplayStatics.h"
 #include "IImageWrapper.h"
@@ -34,6 +35,11 @@ void UGW_MapGeneratorWidget::NativeConstruct()
         MapGenerator = World->SpawnActor<AGW_MapGenerator>(AGW_MapGenerator::StaticClass(), SpawnParams);
     }
 
+    // Create generation history
+    History = NewObject<UGW_MapGenerationHistory>(this);
+    History->MemoryBudgetBytes = int64(HistoryMemoryBudgetMB) * 1024 * 1024;
+    History->MaxHotEntries = HistoryHotEntries;
+
     // Bind buttons
     if (GenerateButton)
     {
@@ -50,6 +56,16 @@ void UGW_MapGeneratorWidget::NativeConstruct()
         SaveImageButton->OnClicked.AddDynamic(this, &UGW_MapGeneratorWidget::OnSaveImageButtonClicked);
     }
 
+    if (UndoButton)
+    {
+        UndoButton->OnClicked.AddDynamic(this, &UGW_MapGeneratorWidget::OnUndoButtonClicked);
+    }
+
+    if (RedoButton)
+    {
+        RedoButton->OnClicked.AddDynamic(this, &UGW_MapGeneratorWidget::OnRedoButtonClicked);
+    }
+
     // Bind sliders
     if (TemperaturePeriodSlider)
     {
@@ -103,6 +119,7 @@ void UGW_MapGeneratorWidget::NativeConstruct()
 
     // Update all labels
     UpdateAllLabels();
+    UpdateHistoryButtons();
 
     // Set initial status
     if (StatusLabel)
@@ -142,6 +159,26 @@ void UGW_MapGeneratorWidget::OnSaveImageButtonClicked()
     SaveMapToFile();
 }
 
+void UGW_MapGeneratorWidget::OnUndoButtonClicked()
+{
+    FGW_MapGenerationParams Params;
+    if (History && History->Undo(Params))
+    {
+        ApplyParamsToInputs(Params);
+        ShowMapForParams(Params, false);
+    }
+}
+
+void UGW_MapGeneratorWidget::OnRedoButtonClicked()
+{
+    FGW_MapGenerationParams Params;
+    if (History && History->Redo(Params))
+    {
+        ApplyParamsToInputs(Params);
+        ShowMapForParams(Params, false);
+    }
+}
+
 void UGW_MapGeneratorWidget::OnTemperaturePeriodChanged(float Value)
 {
     if (TemperaturePeriodLabel)
@@ -213,6 +250,11 @@ void UGW_MapGeneratorWidget::UpdateAllLabels()
 
 void UGW_MapGeneratorWidget::GenerateMap()
 {
+    if (bApplyingHistory)
+    {
+        return;
+    }
+
     if (!MapGenerator)
     {
         if (StatusLabel)
@@ -222,53 +264,52 @@ void UGW_MapGeneratorWidget::GenerateMap()
         return;
     }
 
+    ShowMapForParams(GatherParamsFromInputs(), true);
+}
+
+void UGW_MapGeneratorWidget::ShowMapForParams(const FGW_MapGenerationParams& Params, bool bRecordInTimeline)
+{
+    if (!MapGenerator)
+    {
+        return;
+    }
+
     // Update status
     if (StatusLabel)
     {
         StatusLabel->SetText(FText::FromString("Generating..."));
     }
 
-    // Get values from inputs
-    int32 Seed = GetSeedFromInput();
-    
-    // Get map dimensions
-    int32 Width = 600;
-    int32 Height = 600;
-    if (MapWidthInput)
-    {
-        Width = FCString::Atoi(*MapWidthInput->GetText().ToString());
-        Width = FMath::Clamp(Width, 64, 2000);
-    }
-    if (MapHeightInput)
+    // Reuse a previous result when these exact parameters were generated before
+    UTexture2D* Texture = nullptr;
+    const bool bFromHistory = History && History->Restore(Params, MapGenerator, Texture);
+
+    FGW_MapGenerationParams GeneratedParams = Params;
+    if (!bFromHistory)
     {
-        Height = FCString::Atoi(*MapHeightInput->GetText().ToString());
-        Height = FMath::Clamp(Height, 64, 2000);
-    }
+        // Set map generator parameters and generate the map
+        MapGenerator->ApplyGenerationParams(Params);
+        MapGenerator->GenerateBiomeMap(Params.Seed);
 
-    // Set map generator parameters
-    MapGenerator->GenWidth = Width;
-    MapGenerator->GenHeight = Height;
-    
-    MapGenerator->TemperaturePeriod = TemperaturePeriodSlider ? TemperaturePeriodSlider->GetValue() : 20.0f;
-    MapGenerator->TemperatureOctaves = GetOctaveFromInput(TemperatureOctaveInput, 8);
-    
-    MapGenerator->MoisturePeriod = MoisturePeriodSlider ? MoisturePeriodSlider->GetValue() : 20.0f;
-    MapGenerator->MoistureOctaves = GetOctaveFromInput(MoistureOctaveInput, 8);
-    
-    MapGenerator->AltitudePeriod = AltitudePeriodSlider ? AltitudePeriodSlider->GetValue() : 15.0f;
-    MapGenerator->AltitudeOctaves = GetOctaveFromInput(AltitudeOctaveInput, 7);
-    
-    MapGenerator->VolatilityPeriod = VolatilityPeriodSlider ? VolatilityPeriodSlider->GetValue() : 25.0f;
-    MapGenerator->VolatilityOctaves = GetOctaveFromInput(VolatilityOctaveInput, 4);
-    
-    MapGenerator->EnchantmentPeriod = EnchantmentPeriodSlider ? EnchantmentPeriodSlider->GetValue() : 25.0f;
-    MapGenerator->EnchantmentOctaves = GetOctaveFromInput(EnchantmentOctaveInput, 4);
+        // Seed 0 rolls a random seed, so record the one actually used
+        GeneratedParams.Seed = MapGenerator->Seed;
+
+        // Generate texture
+        Texture = MapGenerator->BuildBiomeTexture();
+
+        if (Texture && History)
+        {
+            History->Store(GeneratedParams, MapGenerator, Texture);
+        }
+    }
 
-    // Generate the map
-    MapGenerator->GenerateBiomeMap(Seed);
+    MapTexture = Texture;
 
-    // Generate texture
-    MapTexture = MapGenerator->GenerateTestDebugTexture();
+    if (bRecordInTimeline && History && MapTexture)
+    {
+        History->PushTimeline(GeneratedParams);
+    }
+    UpdateHistoryButtons();
 
     if (MapTexture && GeneratedMapImage)
     {
@@ -277,8 +318,8 @@ void UGW_MapGeneratorWidget::GenerateMap()
         if (StatusLabel)
         {
             int32 BiomeCount = MapGenerator->GetBiomeMap().Num();
-            FString StatusText = FString::Printf(TEXT("✓ Generated! Seed: %d | Size: %dx%d | Biomes: %d"), 
-                Seed, Width, Height, BiomeCount);
+            FString StatusText = FString::Printf(TEXT("✓ %s! Seed: %d | Size: %dx%d | Biomes: %d"), 
+                bFromHistory ? TEXT("Restored") : TEXT("Generated"), GeneratedParams.Seed, GeneratedParams.Width, GeneratedParams.Height, BiomeCount);
             StatusLabel->SetText(FText::FromString(StatusText));
         }
     }
@@ -291,6 +332,79 @@ void UGW_MapGeneratorWidget::GenerateMap()
     }
 }
 
+FGW_MapGenerationParams UGW_MapGeneratorWidget::GatherParamsFromInputs()
+{
+    FGW_MapGenerationParams Params = MapGenerator ? MapGenerator->GetGenerationParams() : FGW_MapGenerationParams();
+
+    // Get values from inputs
+    Params.Seed = GetSeedFromInput();
+    
+    // Get map dimensions
+    Params.Width = 600;
+    Params.Height = 600;
+    if (MapWidthInput)
+    {
+        Params.Width = FCString::Atoi(*MapWidthInput->GetText().ToString());
+        Params.Width = FMath::Clamp(Params.Width, 64, 2000);
+    }
+    if (MapHeightInput)
+    {
+        Params.Height = FCString::Atoi(*MapHeightInput->GetText().ToString());
+        Params.Height = FMath::Clamp(Params.Height, 64, 2000);
+    }
+
+    Params.TemperaturePeriod = TemperaturePeriodSlider ? TemperaturePeriodSlider->GetValue() : 20.0f;
+    Params.TemperatureOctaves = GetOctaveFromInput(TemperatureOctaveInput, 8);
+    
+    Params.MoisturePeriod = MoisturePeriodSlider ? MoisturePeriodSlider->GetValue() : 20.0f;
+    Params.MoistureOctaves = GetOctaveFromInput(MoistureOctaveInput, 8);
+    
+    Params.AltitudePeriod = AltitudePeriodSlider ? AltitudePeriodSlider->GetValue() : 15.0f;
+    Params.AltitudeOctaves = GetOctaveFromInput(AltitudeOctaveInput, 7);
+    
+    Params.VolatilityPeriod = VolatilityPeriodSlider ? VolatilityPeriodSlider->GetValue() : 25.0f;
+    Params.VolatilityOctaves = GetOctaveFromInput(VolatilityOctaveInput, 4);
+    
+    Params.EnchantmentPeriod = EnchantmentPeriodSlider ? EnchantmentPeriodSlider->GetValue() : 25.0f;
+    Params.EnchantmentOctaves = GetOctaveFromInput(EnchantmentOctaveInput, 4);
+
+    return Params;
+}
+
+void UGW_MapGeneratorWidget::ApplyParamsToInputs(const FGW_MapGenerationParams& Params)
+{
+    TGuardValue<bool> HistoryGuard(bApplyingHistory, true);
+
+    if (TemperaturePeriodSlider) TemperaturePeriodSlider->SetValue(Params.TemperaturePeriod);
+    if (MoisturePeriodSlider) MoisturePeriodSlider->SetValue(Params.MoisturePeriod);
+    if (AltitudePeriodSlider) AltitudePeriodSlider->SetValue(Params.AltitudePeriod);
+    if (VolatilityPeriodSlider) VolatilityPeriodSlider->SetValue(Params.VolatilityPeriod);
+    if (EnchantmentPeriodSlider) EnchantmentPeriodSlider->SetValue(Params.EnchantmentPeriod);
+
+    if (TemperatureOctaveInput) TemperatureOctaveInput->SetText(FText::FromString(FString::FromInt(Params.TemperatureOctaves)));
+    if (MoistureOctaveInput) MoistureOctaveInput->SetText(FText::FromString(FString::FromInt(Params.MoistureOctaves)));
+    if (AltitudeOctaveInput) AltitudeOctaveInput->SetText(FText::FromString(FString::FromInt(Params.AltitudeOctaves)));
+    if (VolatilityOctaveInput) VolatilityOctaveInput->SetText(FText::FromString(FString::FromInt(Params.VolatilityOctaves)));
+    if (EnchantmentOctaveInput) EnchantmentOctaveInput->SetText(FText::FromString(FString::FromInt(Params.EnchantmentOctaves)));
+    if (SeedInput) SeedInput->SetText(FText::FromString(FString::FromInt(Params.Seed)));
+    if (MapWidthInput) MapWidthInput->SetText(FText::FromString(FString::FromInt(Params.Width)));
+    if (MapHeightInput) MapHeightInput->SetText(FText::FromString(FString::FromInt(Params.Height)));
+
+    UpdateAllLabels();
+}
+
+void UGW_MapGeneratorWidget::UpdateHistoryButtons()
+{
+    if (UndoButton)
+    {
+        UndoButton->SetIsEnabled(History && History->CanUndo());
+    }
+    if (RedoButton)
+    {
+        RedoButton->SetIsEnabled(History && History->CanRedo());
+    }
+}
+
 void UGW_MapGeneratorWidget::SaveMapToFile()
 {
     if (!MapTexture)
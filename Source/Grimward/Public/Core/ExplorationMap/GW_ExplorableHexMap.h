@@ -4,6 +4,9 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Core/ExplorationMap/GW_TileTypes.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "Core/ExplorationMap/GW_HexStateTexture.h"
+#include "Core/GW_Logging.h"
 #include "GW_ExplorableHexMap.generated.h"
 /*-------------------------------------------------------------------------*/
 
@@ -13,9 +16,15 @@
 /*  Declarations                                                           */
 /*-------------------------------------------------------------------------*/
 class UCanvasPanel;
+class UInvalidationBox;
+class UImage;
 class UGW_HexTile;
-class AGW_MapGenerator;
-struct FGW_HexTileData;
+class UGW_HexMapCanvas;
+class UGW_HexVisualsAsset;
+class UGW_HexWorldState;
+class UGW_HexPathfinder;
+class UGW_HexRevealService;
+class UGW_HexMinimapWidget;
 /*-------------------------------------------------------------------------*/
 
 
@@ -36,17 +45,124 @@ struct FGW_HexMapConfig
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     float HexHeight = 130.0f;
     
-    /** How many tiles to render beyond viewport edges */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    int32 TileRenderBuffer = 2;
+    /** Extra screen-space margin (widget units) kept spawned around the visible area on every side */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+    float PrefetchMargin = 32.0f;
+    
+    /** Frames of the current pan velocity to prefetch ahead in the direction of travel */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+    float PrefetchLookaheadFrames = 1.0f;
+    
+    /** Longest lookahead (widget units) added on the leading side, so the window and the pool sized for it stay bounded during flings */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+    float PrefetchMaxTravel = 256.0f;
     
     /** Zoom range */
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FVector2D ZoomRange = FVector2D(0.5f, 2.0f);
     
+    /** Upper bound on tile widgets alive at once (spawned + pooled); raised to the widest visible window if that needs more */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+    int32 MaxPoolSize = 600;
+    
+    /** Milliseconds per frame spent creating tile widgets the pool could not supply */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.1"))
+    float TileCreationBudgetMs = 1.0f;
+    
+    /** How quickly the view eases towards the zoom target (0 snaps immediately); pans follow input directly */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+    float CameraInterpSpeed = 15.0f;
+    
+    /** Below this zoom the map is drawn from the biome texture instead of tiles (needs LodImage) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float LodZoomThreshold = 0.75f;
+    
+    /** Seconds to cross-fade between tiles and the LOD image */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+    float LodFadeTime = 0.2f;
+    
+    /** Hexes revealed around an explored hex by RevealAround (occluders permitting) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+    int32 SightRadius = 2;
+    
+    /** Seconds visible hexes take to ease into a new exploration state (0 switches instantly) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+    float StateTransitionTime = 0.35f;
+    
     FGW_HexMapConfig() {}
 };
 
+/*-------------------------------------------------------------------------*/
+/*  Visible Tile Window                                                    */
+/*-------------------------------------------------------------------------*/
+/** Tracks the visible grid rectangle so a pan only touches the rows and columns that crossed its edges */
+struct FGW_HexTileWindow
+{
+    /** Currently visible grid rectangle (Max exclusive) */
+    FIntRect Rect;
+    
+    /** Move the window to NewRect, reporting tiles that left it before tiles that entered it */
+    template<typename LeaveFuncType, typename EnterFuncType>
+    void MoveTo(const FIntRect& NewRect, LeaveFuncType&& OnLeave, EnterFuncType&& OnEnter)
+    {
+        ForEachInDifference(Rect, NewRect, OnLeave);
+        ForEachInDifference(NewRect, Rect, OnEnter);
+        Rect = NewRect;
+    }
+    
+    /** Forget the current window without reporting anything */
+    void Reset() { Rect = FIntRect(); }
+    
+    /** Visit every cell of A that is not in B as at most four edge strips */
+    template<typename FuncType>
+    static void ForEachInDifference(const FIntRect& A, const FIntRect& B, FuncType& Func)
+    {
+        auto VisitStrip = [&Func](int32 MinX, int32 MinY, int32 MaxX, int32 MaxY)
+        {
+            for (int32 Y = MinY; Y < MaxY; ++Y)
+            {
+                for (int32 X = MinX; X < MaxX; ++X)
+                {
+                    Func(FIntPoint(X, Y));
+                }
+            }
+        };
+        
+        const FIntPoint OverlapMin = A.Min.ComponentMax(B.Min);
+        const FIntPoint OverlapMax = A.Max.ComponentMin(B.Max);
+        
+        // No overlap, the whole of A crossed the edge
+        if (OverlapMin.X >= OverlapMax.X || OverlapMin.Y >= OverlapMax.Y)
+        {
+            VisitStrip(A.Min.X, A.Min.Y, A.Max.X, A.Max.Y);
+            return;
+        }
+        
+        VisitStrip(A.Min.X, A.Min.Y, A.Max.X, OverlapMin.Y);            // Rows above
+        VisitStrip(A.Min.X, OverlapMax.Y, A.Max.X, A.Max.Y);            // Rows below
+        VisitStrip(A.Min.X, OverlapMin.Y, OverlapMin.X, OverlapMax.Y);  // Columns left
+        VisitStrip(OverlapMax.X, OverlapMin.Y, A.Max.X, OverlapMax.Y);  // Columns right
+    }
+};
+
+/*-------------------------------------------------------------------------*/
+/*  Map Stats                                                              */
+/*-------------------------------------------------------------------------*/
+/** Counters accumulated since the last ResetStats, read by profiling tools such as the hex map benchmark test */
+struct FGW_HexMapStats
+{
+    /** UpdateVisibleTiles calls and the wall time spent in them */
+    int32 VisibilityUpdates = 0;
+    double VisibilityUpdateSeconds = 0.0;
+    
+    /** Tile widgets given data and placed, by the visibility update or the creation queue */
+    int32 TilesBuilt = 0;
+    
+    /** Tile requests served from TilePool vs. ones that had to create a widget */
+    int32 PoolHits = 0;
+    int32 PoolMisses = 0;
+};
+
 /*-------------------------------------------------------------------------*/
 /*  Explorable Hexagon Map                                                 */
 /*-------------------------------------------------------------------------*/
@@ -61,10 +177,41 @@ protected:
     // Widget Components
     // ========================================
     
-    /** Main canvas that holds all hex tiles */
+    /** Main canvas that holds all hex tiles, laid out in world-pixel space */
     UPROPERTY(meta = (BindWidget))
     UCanvasPanel* MapCanvas;
     
+    /** Optional invalidation box around MapCanvas (and the batched layers). When bound, the tile
+     *  layer is painted from cache and only a changed tile, layer or view transform repaints it. */
+    UPROPERTY(meta = (BindWidgetOptional))
+    UInvalidationBox* TileLayerCache;
+    
+    /** Optional batched hex layer below MapCanvas. When bound, it paints every visible hex
+     *  and UGW_HexTile widgets are only spawned for the selected and hovered hexes. */
+    UPROPERTY(meta = (BindWidgetOptional))
+    UGW_HexMapCanvas* HexCanvas;
+    
+    /** Optional batched layer that paints plain hexes where tile widgets are still queued for creation */
+    UPROPERTY(meta = (BindWidgetOptional))
+    UGW_HexMapCanvas* PlaceholderCanvas;
+    
+    /** Optional far-zoom image inside MapCanvas: biomes masked by exploration state, like the fog layer */
+    UPROPERTY(meta = (BindWidgetOptional))
+    UImage* LodImage;
+    
+    /** Optional tiled hex-grid outline drawn over LodImage (brush should tile one 2-column period) */
+    UPROPERTY(meta = (BindWidgetOptional))
+    UImage* LodGridOverlay;
+    
+    /** Optional fog layer above the tiles (bDrawFog set). When bound, tiles skip their own fog overlay
+     *  and a reveal is a bit operation in UGW_HexWorldState plus one repaint of this layer. */
+    UPROPERTY(meta = (BindWidgetOptional))
+    UGW_HexMapCanvas* FogCanvas;
+    
+    /** Optional overview of the whole map; bound to this map at InitializeMap */
+    UPROPERTY(meta = (BindWidgetOptional))
+    UGW_HexMinimapWidget* Minimap;
+    
     // ========================================
     // Configuration
     // ========================================
@@ -77,6 +224,14 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hex Map")
     FGW_HexMapConfig MapConfig;
     
+    /** Biome/POI atlas brushes shared by every tile, streamed in at InitializeMap */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hex Map")
+    UGW_HexVisualsAsset* HexVisuals;
+    
+    /** Loot placed on every hex with the POI when a new map is bound; a loaded save marks what was taken */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hex Map")
+    TMap<EGW_HexPOI, FGW_HexLootList> POILoot;
+    
     /** Reference to map generator */
     UPROPERTY(BlueprintReadWrite, Category = "Hex Map")
     AGW_MapGenerator* MapGenerator;
@@ -89,7 +244,7 @@ protected:
     // Viewport & Camera State
     // ========================================
     
-    /** Current viewport offset (for panning) */
+    /** Current viewport offset (for panning), derived every tick from the view anchor and CurrentZoom */
     UPROPERTY(BlueprintReadOnly, Category = "Hex Map")
     FVector2D ViewportOffset;
     
@@ -97,6 +252,33 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "Hex Map")
     float CurrentZoom;
     
+    /** World point held under ViewAnchorScreen; panning moves it, zooming keeps it in place */
+    FVector2D ViewAnchorWorld;
+    
+    /** Widget-local point ViewAnchorWorld is drawn at (the viewport centre when it was last set) */
+    FVector2D ViewAnchorScreen;
+    
+    /** Zoom the view is easing towards */
+    float TargetZoom;
+    
+    /** Set when the view or its content changed; NativeTick runs one visibility update for it */
+    bool bVisibilityDirty;
+    
+    /** Time (FPlatformTime::Seconds) after which no more tiles are built this frame */
+    double TileBuildDeadline;
+    
+    /** Pan velocity in world pixels per second, measured over the last tick (drives prefetching) */
+    FVector2D ViewVelocity;
+    
+    /** ViewportOffset at the previous tick, for ViewVelocity */
+    FVector2D LastTickViewportOffset;
+    
+    /** CurrentZoom at the previous tick */
+    float LastTickZoom;
+    
+    /** Duration of the previous frame */
+    float LastTickDeltaTime;
+    
     /** Last center grid position (for culling) */
     UPROPERTY(BlueprintReadOnly, Category = "Hex Map")
     FIntPoint LastCenterGridPos;
@@ -105,6 +287,14 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "Hex Map")
     UGW_HexTile* ActiveTile;
     
+    /** Grid position of the selected tile (survives the widget being recycled) */
+    UPROPERTY(BlueprintReadOnly, Category = "Hex Map")
+    FIntPoint ActiveGridPos;
+    
+    /** Grid position under the cursor */
+    UPROPERTY(BlueprintReadOnly, Category = "Hex Map")
+    FIntPoint HoveredGridPos;
+    
     // ========================================
     // Tile Management
     // ========================================
@@ -117,6 +307,41 @@ protected:
     UPROPERTY()
     TArray<UGW_HexTile*> TilePool;
     
+    /** One texel per hex, shown by LodImage; follows the world state's change notifications */
+    UPROPERTY()
+    FGW_HexStateTexture LodTexture;
+    
+    /** 0 = tiles, 1 = LOD image; eased towards the target in NativeTick */
+    float LodBlend;
+    
+    /** Grid rectangle the spawned tiles currently cover */
+    FGW_HexTileWindow TileWindow;
+    
+    /** Visible tiles waiting for a widget, created a few per frame in NativeTick */
+    TArray<FIntPoint> PendingTileCoords;
+    
+    /** Profiling counters, see GetStats */
+    FGW_HexMapStats Stats;
+    
+    /** Stats at the last summary line, and frames since; per-tile work is logged as these totals */
+    FGW_HexMapStats LoggedStats;
+    int32 LoggedFrames = 0;
+    FGW_LogRateLimiter SummaryLogLimiter;
+    
+    // ========================================
+    // State Transitions
+    // ========================================
+    
+    /** Visible hexes easing into a new exploration state, advanced together in NativeTick */
+    TArray<FGW_HexTileTransition> ActiveTransitions;
+    
+    /** Index into ActiveTransitions per animating hex */
+    TMap<FIntPoint, int32> TransitionIndices;
+    
+    /** States of the visible rectangle as last seen, so a change report can tell what actually changed */
+    FIntRect KnownStateRect;
+    TArray<EGW_HexTileState> KnownStates;
+    
     // ========================================
     // Input State
     // ========================================
@@ -126,6 +351,23 @@ protected:
     
     /** Last mouse position for drag calculations */
     FVector2D LastDragPosition;
+    
+    /** Hex under the cursor when the left button went down */
+    FIntPoint PressedGridPos;
+    
+    /** Subscription to UGW_HexWorldState changes */
+    FDelegateHandle ExplorationChangedHandle;
+    
+    // ========================================
+    // Scratch Buffers
+    // ========================================
+    
+    /** Tiles that became visible this update, batch-read from the world state */
+    TArray<FIntPoint> NewTileCoords;
+    TArray<FGW_HexTileData> NewTileData;
+    
+    /** States of a changed rectangle, compared against KnownStates */
+    TArray<EGW_HexTileState> ChangedStates;
 
 public:
     // ========================================
@@ -133,6 +375,7 @@ public:
     // ========================================
     
     virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
     virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
     
     /** Initialize map with a specific seed and starting position */
@@ -167,34 +410,51 @@ public:
     // Coordinate Conversion
     // ========================================
     
-    /** Convert axial hex coordinates to pixel position */
+    /** Top-left world pixel position of the tile at an odd-q grid position */
     UFUNCTION(BlueprintPure, Category = "Hex Map")
     FVector2D GridToPixel(FIntPoint GridPos) const;
     
-    /** Convert pixel position to axial hex coordinates */
+    /** Convert a world pixel position to the grid position of the hex containing it (exact, cube-rounded) */
     UFUNCTION(BlueprintPure, Category = "Hex Map")
     FIntPoint PixelToGrid(FVector2D PixelPos) const;
     
+    /** Grid position under a screen-space point, given this widget's geometry */
+    FIntPoint ScreenToGrid(const FGeometry& InGeometry, FVector2D ScreenSpacePos) const;
+    
+    /** Area the view shows, in fractional columns and rows (approximate; for overviews such as the minimap) */
+    FBox2D GetViewGridBounds() const;
+    
     /** Get screen position accounting for viewport offset and zoom */
     UFUNCTION(BlueprintPure, Category = "Hex Map")
     FVector2D GetScreenPosition(FVector2D WorldPixelPos) const;
     
+    /** Push the current pan/zoom to MapCanvas as one render transform (tiles keep their world-pixel slots) */
+    UFUNCTION(BlueprintCallable, Category = "Hex Map")
+    void ApplyViewTransform();
+    
     // ========================================
     // Camera Control
     // ========================================
     
-    /** Pan the viewport by delta */
+    /** Pan the view by a delta in widget-local units (applied on the next tick) */
     UFUNCTION(BlueprintCallable, Category = "Hex Map")
     void PanViewport(FVector2D Delta);
     
-    /** Set zoom level (clamped to config range) */
+    /** Set the target zoom level (clamped to config range); the view eases to it around the viewport centre */
     UFUNCTION(BlueprintCallable, Category = "Hex Map")
     void SetZoom(float NewZoom);
     
-    /** Center viewport on specific grid position */
+    /** Move the view so GridPos is centred */
     UFUNCTION(BlueprintCallable, Category = "Hex Map")
     void CenterOnGridPosition(FIntPoint GridPos);
     
+    /** Jump straight to the target zoom and update visibility now */
+    UFUNCTION(BlueprintCallable, Category = "Hex Map")
+    void SnapViewToTarget();
+    
+    /** Offset that draws ViewAnchorWorld at ViewAnchorScreen at CurrentZoom */
+    FVector2D GetAnchoredViewportOffset() const;
+    
     // ========================================
     // Input Handling
     // ========================================
@@ -203,6 +463,7 @@ public:
     virtual FReply NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
     virtual FReply NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
     virtual FReply NativeOnMouseWheel(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+    virtual void NativeOnMouseLeave(const FPointerEvent& InMouseEvent) override;
     
     // ========================================
     // Tile Selection
@@ -212,19 +473,64 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Hex Map")
     void SetActiveTile(UGW_HexTile* Tile);
     
+    /** Select the hex at GridPos and route the click to its tile widget */
+    UFUNCTION(BlueprintCallable, Category = "Hex Map")
+    void ClickGridPosition(FIntPoint GridPos);
+    
+    /** Move hover to GridPos, notifying the tiles that lost and gained it */
+    UFUNCTION(BlueprintCallable, Category = "Hex Map")
+    void SetHoveredGridPosition(FIntPoint GridPos);
+    
     /** Get currently active tile */
     UFUNCTION(BlueprintPure, Category = "Hex Map")
     UGW_HexTile* GetActiveTile() const { return ActiveTile; }
     
+    /** Exploration store of the world this map lives in */
+    UFUNCTION(BlueprintPure, Category = "Hex Map")
+    UGW_HexWorldState* GetHexWorldState() const;
+    
+    /** Travel queries over this map */
+    UFUNCTION(BlueprintPure, Category = "Hex Map")
+    UGW_HexPathfinder* GetHexPathfinder() const;
+    
+    /** Field-of-view and reveal queries over this map */
+    UFUNCTION(BlueprintPure, Category = "Hex Map")
+    UGW_HexRevealService* GetHexRevealService() const;
+    
+    /** Reveal everything visible from GridPos within MapConfig.SightRadius as one exploration change */
+    UFUNCTION(BlueprintCallable, Category = "Hex Map")
+    void RevealAround(FIntPoint GridPos);
+    
     // ========================================
     // Utility
     // ========================================
     
-    /** Get all hex neighbors of a grid position */
+    /** Counters accumulated since the last ResetStats */
+    const FGW_HexMapStats& GetStats() const { return Stats; }
+    void ResetStats() { Stats = LoggedStats = FGW_HexMapStats(); }
+    
+    UFUNCTION(BlueprintPure, Category = "Hex Map")
+    int32 GetSpawnedTileCount() const { return SpawnedTiles.Num(); }
+    
+    UFUNCTION(BlueprintPure, Category = "Hex Map")
+    int32 GetPooledTileCount() const { return TilePool.Num(); }
+    
+    /** Visible hexes still queued for a tile widget */
+    UFUNCTION(BlueprintPure, Category = "Hex Map")
+    int32 GetPendingTileCount() const { return PendingTileCoords.Num(); }
+    
+    /** Queued hexes the placeholder layer paints as plain hexes (none without PlaceholderCanvas) */
+    UFUNCTION(BlueprintPure, Category = "Hex Map")
+    int32 GetPlaceholderHexCount() const { return PlaceholderCanvas ? PendingTileCoords.Num() : 0; }
+    
+    /** Tile widgets allowed at once: MaxPoolSize, but never fewer than a full window needs */
+    int32 GetTilePoolCap() const;
+    
+    /** The six neighbours of a grid position, clockwise from north-east */
     UFUNCTION(BlueprintPure, Category = "Hex Map")
     TArray<FIntPoint> GetHexNeighbors(FIntPoint GridPos) const;
     
-    /** Calculate distance between two hex positions */
+    /** Number of single-hex steps between two grid positions */
     UFUNCTION(BlueprintPure, Category = "Hex Map")
     int32 GetHexDistance(FIntPoint A, FIntPoint B) const;
     
@@ -233,14 +539,89 @@ protected:
     // Internal Helpers
     // ========================================
     
+    /** Build a hex tile widget from an already fetched world state snapshot */
+    UGW_HexTile* BuildHexTileFromData(const FGW_HexTileData& TileData);
+    
+    /** Re-apply visuals on spawned tiles once the atlases have streamed in */
+    void OnHexVisualsLoaded();
+    
+    /** Sync spawned tiles and the fog layer with a batch of exploration changes */
+    void OnExplorationChanged(const FIntRect& DirtyRect);
+    
+    /** Put POILoot on the POIs of a freshly bound map */
+    void PlacePOILoot(UGW_HexWorldState* WorldState);
+    
+    /** Build the LOD texture from the world state and lay LodImage/LodGridOverlay over the whole map */
+    void SetupLodLayer();
+    
+    /** True when the current zoom is below the LOD threshold and a LOD image is available */
+    bool WantsLod() const;
+    
+    /** Ease LodBlend towards its target and apply it to the layers */
+    void UpdateLodBlend(float DeltaTime);
+    
+    /** Push the current view and visible rect to the batched canvas layers */
+    void UpdateCanvasLayers(const FIntRect& VisibleRect);
+    
+    /** Re-read KnownStates when the visible rectangle moved */
+    void SyncKnownStates(const FIntRect& VisibleRect);
+    
+    /** Ease GridPos from one state to another, restarting it if it was already animating */
+    void StartTransition(FIntPoint GridPos, EGW_HexTileState From, EGW_HexTileState To);
+    
+    /** Step every active transition by DeltaTime, apply it to spawned tiles and the fog layer, drop finished ones */
+    void AdvanceTransitions(float DeltaTime);
+    
+    /** Stop every transition where it is (tiles keep their final state) */
+    void ClearTransitions();
+    
     /** Get or create a tile from pool */
     UGW_HexTile* GetTileFromPool();
     
-    /** Return tile to pool for reuse */
+    /** Return tile to pool for reuse (collapsed, still under MapCanvas), or release it if the pool is at the cap */
     void ReturnTileToPool(UGW_HexTile* Tile);
     
+    /** Parent a tile to MapCanvas with the hex size and a top-left anchor */
+    void AddTileToCanvas(UGW_HexTile* Tile);
+    
+    /** Create tile widgets up front until spawned + pooled reaches TargetCount (bounded by the pool cap) */
+    void PrewarmTilePool(int32 TargetCount);
+    
+    /** Release pooled widgets until at most MaxPooled remain */
+    void TrimTilePool(int32 MaxPooled);
+    
+    /** Create widgets for queued tiles until the frame budget runs out */
+    void ProcessPendingTiles();
+    
+    /** Start a tile build budget of BudgetMs from now (negative for unlimited) */
+    void BeginTileBuildBudget(float BudgetMs);
+    
+    /** Whether the current build budget still has time left */
+    bool HasTileBuildBudget() const;
+    
+    /** Mirror the creation queue onto the placeholder layer */
+    void UpdatePlaceholders();
+    
+    /** Largest number of tiles the window can cover (at minimum zoom, with the full lookahead) */
+    int32 CalculateMaxVisibleTileCount() const;
+    
+    /** Size of the area the map is shown in, in widget-local (DPI-independent) units */
+    FVector2D GetViewportSize() const;
+    
+    /** Write the work done since the last summary as one Verbose line, at most once a second */
+    void LogFrameSummary();
+    
+    /** Remove every spawned tile and forget the visible window */
+    void ResetVisibleTiles();
+    
+    /** Spawn widgets for the selected and hovered hexes on top of the batched canvas */
+    void UpdateInteractiveTiles(const FIntRect& VisibleRect);
+    
     /** Calculate which tiles should be visible */
     TArray<FIntPoint> CalculateVisibleTileRange() const;
+    
+    /** Grid rectangle (Max exclusive) covering the visible tiles */
+    FIntRect CalculateVisibleGridRect() const;
 };
 #pragma endregion
 /*-------------------------------------------------------------------------*/
\ No newline at end of file
@@ -0,0 +1,343 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+/**
+ * Hex grid maths for the exploration map: flat-topped hexes stored in odd-q offset
+ * coordinates (X = column, Y = row, odd columns shifted down half a hex).
+ *
+ * Everything here is header-only and allocation-free. Algorithms work in axial
+ * coordinates (Q = column, R = row minus half the column, S = -Q - R) and convert
+ * back to offsets at the edges. Compile-time checks live in GW_HexMath.cpp.
+ */
+namespace GW_HexMath
+{
+    // ========================================
+    // Coordinates
+    // ========================================
+
+    /** Axial hex coordinate; the cube S component is implied */
+    struct FAxial
+    {
+        int32 Q = 0;
+        int32 R = 0;
+
+        constexpr FAxial() = default;
+        constexpr FAxial(int32 InQ, int32 InR) : Q(InQ), R(InR) {}
+
+        constexpr int32 S() const { return -Q - R; }
+
+        constexpr FAxial operator+(const FAxial& Other) const { return FAxial(Q + Other.Q, R + Other.R); }
+        constexpr FAxial operator-(const FAxial& Other) const { return FAxial(Q - Other.Q, R - Other.R); }
+        constexpr FAxial operator*(int32 Scale) const { return FAxial(Q * Scale, R * Scale); }
+        constexpr bool operator==(const FAxial& Other) const { return Q == Other.Q && R == Other.R; }
+        constexpr bool operator!=(const FAxial& Other) const { return !(*this == Other); }
+    };
+
+    /** floor(Value / 2), also for negative columns */
+    constexpr int32 FloorHalf(int32 Value)
+    {
+        return (Value - (Value & 1)) / 2;
+    }
+
+    constexpr FAxial OffsetToAxial(int32 Column, int32 Row)
+    {
+        return FAxial(Column, Row - FloorHalf(Column));
+    }
+
+    constexpr int32 AxialToOffsetRow(const FAxial& Hex)
+    {
+        return Hex.R + FloorHalf(Hex.Q);
+    }
+
+    inline FAxial ToAxial(FIntPoint GridPos)
+    {
+        return OffsetToAxial(GridPos.X, GridPos.Y);
+    }
+
+    inline FIntPoint ToOffset(const FAxial& Hex)
+    {
+        return FIntPoint(Hex.Q, AxialToOffsetRow(Hex));
+    }
+
+    // ========================================
+    // Neighbours & Distance
+    // ========================================
+
+    /** Axial step per direction, clockwise from north-east: NE, SE, S, SW, NW, N */
+    inline constexpr FAxial Directions[6] = {
+        FAxial(1, -1), FAxial(1, 0), FAxial(0, 1), FAxial(-1, 1), FAxial(-1, 0), FAxial(0, -1)
+    };
+
+    /** The same directions as odd-q offset steps, indexed by column parity (X & 1) */
+    inline constexpr int32 OffsetNeighborDX[2][6] = { { 1, 1, 0, -1, -1, 0 }, { 1, 1, 0, -1, -1, 0 } };
+    inline constexpr int32 OffsetNeighborDY[2][6] = { { -1, 0, 1, 0, -1, -1 }, { 0, 1, 1, 1, 0, -1 } };
+
+    constexpr FAxial Neighbor(const FAxial& Hex, int32 Direction)
+    {
+        return Hex + Directions[Direction];
+    }
+
+    inline FIntPoint Neighbor(FIntPoint GridPos, int32 Direction)
+    {
+        const int32 Parity = GridPos.X & 1;
+        return FIntPoint(GridPos.X + OffsetNeighborDX[Parity][Direction], GridPos.Y + OffsetNeighborDY[Parity][Direction]);
+    }
+
+    constexpr int32 AbsInt(int32 Value)
+    {
+        return Value < 0 ? -Value : Value;
+    }
+
+    /** Number of single-hex steps between A and B */
+    constexpr int32 Distance(const FAxial& A, const FAxial& B)
+    {
+        const FAxial Delta = A - B;
+        return (AbsInt(Delta.Q) + AbsInt(Delta.R) + AbsInt(Delta.S())) / 2;
+    }
+
+    inline int32 Distance(FIntPoint A, FIntPoint B)
+    {
+        return Distance(ToAxial(A), ToAxial(B));
+    }
+
+    /** Hexes at exactly Radius steps from a centre */
+    constexpr int32 RingCount(int32 Radius)
+    {
+        return Radius == 0 ? 1 : 6 * Radius;
+    }
+
+    /** Hexes within Radius steps of a centre, centre included */
+    constexpr int32 RangeCount(int32 Radius)
+    {
+        return 3 * Radius * (Radius + 1) + 1;
+    }
+
+    // ========================================
+    // Rounding & Pixels
+    // ========================================
+
+    /** floor(Value + 0.5), usable in constant expressions */
+    constexpr double RoundHalfUp(double Value)
+    {
+        const double Shifted = Value + 0.5;
+        const double Truncated = (double)(int64)Shifted;
+        return Truncated > Shifted ? Truncated - 1.0 : Truncated;
+    }
+
+    /** Cube rounding: round all three components, then rebuild the one with the largest error */
+    constexpr FAxial RoundAxial(double Q, double R)
+    {
+        const double S = -Q - R;
+        double RoundQ = RoundHalfUp(Q);
+        double RoundR = RoundHalfUp(R);
+        const double RoundS = RoundHalfUp(S);
+
+        const double DiffQ = RoundQ > Q ? RoundQ - Q : Q - RoundQ;
+        const double DiffR = RoundR > R ? RoundR - R : R - RoundR;
+        const double DiffS = RoundS > S ? RoundS - S : S - RoundS;
+
+        if (DiffQ > DiffR && DiffQ > DiffS)
+        {
+            RoundQ = -RoundR - RoundS;
+        }
+        else if (DiffR > DiffS)
+        {
+            RoundR = -RoundQ - RoundS;
+        }
+        return FAxial((int32)RoundQ, (int32)RoundR);
+    }
+
+    /**
+     * Hex containing a pixel, with tiles HexWidth x HexHeight placed by their top-left
+     * corner (the layout of UGW_ExplorableHexMap::GridToPixel).
+     */
+    constexpr FAxial PixelToAxial(double PixelX, double PixelY, double HexWidth, double HexHeight)
+    {
+        const double Q = (PixelX - HexWidth * 0.5) / (HexWidth * 0.75);
+        const double R = (PixelY - HexHeight * 0.5) / HexHeight - Q * 0.5;
+        return RoundAxial(Q, R);
+    }
+
+    /** Top-left corner of a tile's box */
+    inline FVector2D GridToPixel(FIntPoint GridPos, const FVector2D& HexSize)
+    {
+        return FVector2D(GridPos.X * HexSize.X * 0.75, GridPos.Y * HexSize.Y + (GridPos.X & 1) * HexSize.Y * 0.5);
+    }
+
+    inline FVector2D GridToPixelCenter(FIntPoint GridPos, const FVector2D& HexSize)
+    {
+        return GridToPixel(GridPos, HexSize) + HexSize * 0.5;
+    }
+
+    inline FIntPoint PixelToGrid(const FVector2D& PixelPos, const FVector2D& HexSize)
+    {
+        return ToOffset(PixelToAxial(PixelPos.X, PixelPos.Y, HexSize.X, HexSize.Y));
+    }
+
+    // ========================================
+    // Iterators
+    // ========================================
+
+    /** Hexes at exactly Radius steps, clockwise from the north-west corner. Use in range-for. */
+    struct FRing
+    {
+        struct FIterator
+        {
+            FAxial Hex;
+            int32 Radius = 0;
+            int32 Side = 0;
+            int32 Step = 0;
+
+            constexpr FAxial operator*() const { return Hex; }
+            constexpr bool operator!=(const FIterator& Other) const { return Side != Other.Side || Step != Other.Step; }
+
+            constexpr FIterator& operator++()
+            {
+                Hex = Hex + Directions[Side];
+                if (++Step >= Radius)
+                {
+                    Step = 0;
+                    Side++;
+                }
+                return *this;
+            }
+        };
+
+        FAxial Center;
+        int32 Radius = 0;
+
+        constexpr FRing(const FAxial& InCenter, int32 InRadius) : Center(InCenter), Radius(InRadius) {}
+
+        constexpr FIterator begin() const
+        {
+            // Radius 0 yields the centre once: start on the last side with a one-step length
+            return Radius > 0
+                ? FIterator{ Center + Directions[4] * Radius, Radius, 0, 0 }
+                : FIterator{ Center, 1, 5, 0 };
+        }
+
+        constexpr FIterator end() const { return FIterator{ Center, Radius, 6, 0 }; }
+    };
+
+    /** Hexes within Radius steps, column by column. Use in range-for. */
+    struct FRange
+    {
+        struct FIterator
+        {
+            FAxial Center;
+            int32 Radius = 0;
+            int32 DQ = 0;
+            int32 DR = 0;
+
+            constexpr FAxial operator*() const { return Center + FAxial(DQ, DR); }
+            constexpr bool operator!=(const FIterator& Other) const { return DQ != Other.DQ || DR != Other.DR; }
+
+            constexpr FIterator& operator++()
+            {
+                const int32 MaxDR = -DQ + Radius < Radius ? -DQ + Radius : Radius;
+                if (++DR > MaxDR)
+                {
+                    DQ++;
+                    DR = -DQ - Radius > -Radius ? -DQ - Radius : -Radius;
+                    if (DQ > Radius)
+                    {
+                        DR = 0;
+                    }
+                }
+                return *this;
+            }
+        };
+
+        FAxial Center;
+        int32 Radius = 0;
+
+        constexpr FRange(const FAxial& InCenter, int32 InRadius) : Center(InCenter), Radius(InRadius) {}
+
+        constexpr FIterator begin() const
+        {
+            return Radius >= 0 ? FIterator{ Center, Radius, -Radius, 0 } : end();
+        }
+
+        constexpr FIterator end() const { return FIterator{ Center, Radius, Radius + 1, 0 }; }
+    };
+
+    /** Centre first, then every ring outwards up to Radius. Use in range-for. */
+    struct FSpiral
+    {
+        struct FIterator
+        {
+            FAxial Center;
+            int32 MaxRadius = 0;
+            int32 Radius = 0;
+            FRing::FIterator RingIt;
+
+            constexpr FAxial operator*() const { return *RingIt; }
+            constexpr bool operator!=(const FIterator& Other) const { return Radius != Other.Radius || RingIt != Other.RingIt; }
+
+            constexpr FIterator& operator++()
+            {
+                ++RingIt;
+                if (RingIt.Side >= 6 && Radius < MaxRadius)
+                {
+                    RingIt = FRing(Center, ++Radius).begin();
+                }
+                else if (RingIt.Side >= 6)
+                {
+                    Radius++;
+                }
+                return *this;
+            }
+        };
+
+        FAxial Center;
+        int32 Radius = 0;
+
+        constexpr FSpiral(const FAxial& InCenter, int32 InRadius) : Center(InCenter), Radius(InRadius) {}
+
+        constexpr FIterator begin() const
+        {
+            return Radius >= 0 ? FIterator{ Center, Radius, 0, FRing(Center, 0).begin() } : end();
+        }
+
+        constexpr FIterator end() const { return FIterator{ Center, Radius, Radius + 1, FRing(Center, 0).end() }; }
+    };
+
+    /** Hexes on the straight line from A to B, both included. Use in range-for. */
+    struct FLine
+    {
+        struct FIterator
+        {
+            FAxial Start;
+            FAxial Delta;
+            int32 Steps = 0;
+            int32 Index = 0;
+
+            constexpr FAxial operator*() const
+            {
+                // Nudge off the exact hex edges so ties always round the same way
+                const double T = Steps > 0 ? (double)Index / Steps : 0.0;
+                return RoundAxial(Start.Q + Delta.Q * T + 1e-6, Start.R + Delta.R * T + 2e-6);
+            }
+
+            constexpr bool operator!=(const FIterator& Other) const { return Index != Other.Index; }
+            constexpr FIterator& operator++() { Index++; return *this; }
+        };
+
+        FAxial A;
+        FAxial B;
+
+        constexpr FLine(const FAxial& InA, const FAxial& InB) : A(InA), B(InB) {}
+
+        constexpr FIterator begin() const { return FIterator{ A, B - A, Distance(A, B), 0 }; }
+        constexpr FIterator end() const { return FIterator{ A, B - A, Distance(A, B), Distance(A, B) + 1 }; }
+    };
+}
+/*-------------------------------------------------------------------------*/
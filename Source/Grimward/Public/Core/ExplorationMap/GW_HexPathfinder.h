@@ -0,0 +1,203 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/ExplorationMap/GW_TileTypes.h"
+#include "GW_HexPathfinder.generated.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+class UGW_HexWorldState;
+
+/** What it costs to step into a hex */
+USTRUCT(BlueprintType)
+struct GRIMWARD_API FGW_HexTravelRules
+{
+    GENERATED_BODY()
+    
+    FGW_HexTravelRules();
+    
+    /** Cost of entering a hex of each biome; 0 or less makes the biome impassable */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Travel")
+    TMap<EGW_HexBiome, int32> BiomeCosts;
+    
+    /** Cost for biomes missing from BiomeCosts */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Travel", meta = (ClampMin = "1"))
+    int32 DefaultCost = 2;
+    
+    /** Whether routes may cross unexplored hexes at all */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Travel")
+    bool bCanEnterHidden = true;
+    
+    /** Added to the biome cost of unexplored hexes */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Travel", meta = (ClampMin = "0", EditCondition = "bCanEnterHidden"))
+    int32 HiddenExtraCost = 0;
+};
+
+/**
+ * Cheapest travel cost from a set of source hexes to every hex reachable within a budget.
+ * Costs are stored densely over Bounds, the furthest the budget could possibly reach.
+ */
+struct GRIMWARD_API FGW_HexDistanceMap
+{
+    static constexpr int32 Unreachable = MAX_int32;
+    
+    TArray<FIntPoint> Sources;
+    int32 Budget = 0;
+    
+    /** Grid rectangle covered by Costs (Max exclusive) */
+    FIntRect Bounds;
+    
+    /** Row-major over Bounds */
+    TArray<int32> Costs;
+    
+    int32 GetCost(FIntPoint GridPos) const
+    {
+        return Bounds.Contains(GridPos)
+            ? Costs[(GridPos.Y - Bounds.Min.Y) * Bounds.Width() + (GridPos.X - Bounds.Min.X)]
+            : Unreachable;
+    }
+    
+    bool IsReachable(FIntPoint GridPos) const { return GetCost(GridPos) != Unreachable; }
+};
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Hex Pathfinder                                                         */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexPathfinder.h
+/**
+ * Travel queries over the map bound to UGW_HexWorldState. Keeps one dense cost per hex, derived
+ * from the biome and exploration state, and updates it only where the world state reports changes
+ * (a newly bound map is one full-map change, so there is nothing to set up per map).
+ * Point-to-point routes use A* over pooled node arrays; "reachable within N" queries use
+ * multi-source Dijkstra maps that stay cached until a change touches their bounds.
+ */
+UCLASS()
+class GRIMWARD_API UGW_HexPathfinder : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Travel cost of hexes that cannot be entered */
+    static constexpr uint16 Impassable = MAX_uint16;
+    
+    /** Distance maps kept before the least recently used one is recycled */
+    static constexpr int32 MaxCachedDistanceMaps = 8;
+    
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    
+    // ========================================
+    // Setup
+    // ========================================
+    
+    UFUNCTION(BlueprintCallable, Category = "Hex Pathfinding")
+    void SetTravelRules(const FGW_HexTravelRules& InRules);
+    
+    UFUNCTION(BlueprintPure, Category = "Hex Pathfinding")
+    FGW_HexTravelRules GetTravelRules() const { return Rules; }
+    
+    // ========================================
+    // Queries
+    // ========================================
+    
+    /** Cost of stepping into a hex, or -1 if it cannot be entered */
+    UFUNCTION(BlueprintPure, Category = "Hex Pathfinding")
+    int32 GetTravelCost(FIntPoint GridPos) const;
+    
+    /**
+     * Cheapest route from Start to Goal, both included, written into OutPath.
+     * Returns false (and an empty path) when Goal cannot be reached.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Hex Pathfinding")
+    bool FindPath(FIntPoint Start, FIntPoint Goal, TArray<FIntPoint>& OutPath, int32& OutCost);
+    
+    /**
+     * Costs from the nearest of Sources to every hex reachable within Budget. Cached per
+     * sources/budget; the reference stays valid until the next distance map query.
+     */
+    const FGW_HexDistanceMap& GetDistanceMap(TArrayView<const FIntPoint> Sources, int32 Budget);
+    
+    /** Every hex reachable from Sources within Budget; returns the number found */
+    UFUNCTION(BlueprintCallable, Category = "Hex Pathfinding")
+    int32 GetReachableHexes(const TArray<FIntPoint>& Sources, int32 Budget, TArray<FIntPoint>& OutHexes);
+
+private:
+    /** Heap entry; ties break on index so results are deterministic */
+    struct FOpenNode
+    {
+        int32 Priority;
+        int32 Cost;
+        int32 Index;
+        
+        bool operator<(const FOpenNode& Other) const
+        {
+            return Priority < Other.Priority || (Priority == Other.Priority && Index < Other.Index);
+        }
+    };
+    
+    struct FCachedDistanceMap
+    {
+        FGW_HexDistanceMap Map;
+        uint32 LastUsed = 0;
+        bool bValid = false;
+    };
+    
+    void OnExplorationChanged(const FIntRect& DirtyRect);
+    
+    /** Size the cost grid and node pool to the world state's map and recompute every cost */
+    void ResetGrid();
+    
+    /** Resolve Rules into the per-biome table and the cheapest possible step */
+    void RebuildBiomeCostTable();
+    
+    /** Recompute costs in Rect; returns the rectangle whose costs actually changed (empty if none) */
+    FIntRect RefreshTravelCosts(const FIntRect& Rect);
+    
+    void BuildDistanceMap(FGW_HexDistanceMap& Map);
+    
+    int32 GetMapIndex(int32 X, int32 Y) const { return Y * MapSize.X + X; }
+    
+    UPROPERTY()
+    UGW_HexWorldState* WorldState = nullptr;
+    
+    FDelegateHandle ExplorationChangedHandle;
+    
+    FGW_HexTravelRules Rules;
+    
+    /** Entry cost per biome, indexed by EGW_HexBiome */
+    TArray<uint16> BiomeCostTable;
+    
+    /** Cheapest passable step, scales the A* heuristic and bounds distance maps */
+    int32 MinStepCost = 1;
+    
+    FIntPoint MapSize = FIntPoint::ZeroValue;
+    
+    /** Entry cost per hex, row-major like the world state */
+    TArray<uint16> TravelCosts;
+    
+    // A* node pool: entries are only valid where NodeStamp matches the current search
+    TArray<int32> NodeCost;
+    TArray<int32> NodeParent;
+    TArray<uint32> NodeStamp;
+    uint32 SearchStamp = 0;
+    
+    TArray<FOpenNode> OpenHeap;
+    
+    TArray<FCachedDistanceMap> DistanceMaps;
+    uint32 DistanceMapUseCounter = 0;
+    
+    // Scratch for cost refreshes
+    TArray<EGW_HexBiome> BiomeScratch;
+    TArray<EGW_HexTileState> StateScratch;
+};
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,144 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/ExplorationMap/GW_TileTypes.h"
+#include "GW_HexRevealService.generated.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+class UGW_HexWorldState;
+struct FGW_HexRevealMask;
+
+/** What blocks line of sight */
+USTRUCT(BlueprintType)
+struct GRIMWARD_API FGW_HexSightRules
+{
+    GENERATED_BODY()
+    
+    FGW_HexSightRules();
+    
+    /** Biomes that hide everything behind them; the blocking hex itself is still seen */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sight")
+    TArray<EGW_HexBiome> OccludingBiomes;
+};
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Hex Reveal Service                                                     */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexRevealService.h
+/**
+ * Field-of-view and reveal queries for exploration. Sight is shadowcast ring by ring:
+ * every hex of ring R covers 1/(6R) of a turn, an occluder casts its slice as shadow onto
+ * the rings behind it, and a hex is seen while its centre angle is still lit.
+ * Reveals collect every seen hex into one FGW_HexRevealMask and apply it to
+ * UGW_HexWorldState in a single call, so the UI receives one change set per reveal.
+ * Occluders come from the world state's biomes and follow its change notifications.
+ */
+UCLASS()
+class GRIMWARD_API UGW_HexRevealService : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    
+    // ========================================
+    // Setup
+    // ========================================
+    
+    UFUNCTION(BlueprintCallable, Category = "Hex Reveal")
+    void SetSightRules(const FGW_HexSightRules& InRules);
+    
+    UFUNCTION(BlueprintPure, Category = "Hex Reveal")
+    FGW_HexSightRules GetSightRules() const { return Rules; }
+    
+    // ========================================
+    // Queries
+    // ========================================
+    
+    /** Whether the hex blocks sight */
+    UFUNCTION(BlueprintPure, Category = "Hex Reveal")
+    bool IsOccluder(FIntPoint GridPos) const;
+    
+    /** True if no occluder lies strictly between From and To */
+    UFUNCTION(BlueprintPure, Category = "Hex Reveal")
+    bool HasLineOfSight(FIntPoint From, FIntPoint To) const;
+    
+    /** Every on-map hex visible from Origin within Radius, Origin first; returns the count */
+    UFUNCTION(BlueprintCallable, Category = "Hex Reveal")
+    int32 ComputeFieldOfView(FIntPoint Origin, int32 Radius, TArray<FIntPoint>& OutVisible);
+    
+    // ========================================
+    // Reveal
+    // ========================================
+    
+    /** Reveal what Origin can see within Radius; returns the number of hexes seen */
+    UFUNCTION(BlueprintCallable, Category = "Hex Reveal")
+    int32 RevealFrom(FIntPoint Origin, int32 Radius);
+    
+    /** Reveal what any of Origins can see within Radius as one change; returns hexes seen (per origin) */
+    UFUNCTION(BlueprintCallable, Category = "Hex Reveal")
+    int32 RevealFromMany(const TArray<FIntPoint>& Origins, int32 Radius);
+    
+    int32 RevealFromOrigins(TArrayView<const FIntPoint> Origins, int32 Radius);
+
+private:
+    void OnExplorationChanged(const FIntRect& DirtyRect);
+    
+    /** Size the occluder bitmap to the world state's map and rebuild all of it */
+    void ResetOccluders();
+    
+    /** Re-derive the occluders of Rect from the world state's biomes */
+    void RefreshOccluders(const FIntRect& Rect);
+    
+    /** Shadowcast from Origin, calling Visit(GridPos) for every visible on-map hex */
+    template<typename FuncType>
+    int32 CastFieldOfView(FIntPoint Origin, int32 Radius, FuncType&& Visit);
+    
+    /** Grid rectangle (Max exclusive, clipped to the map) that a cast from Origin can touch */
+    FIntRect GetSightBounds(FIntPoint Origin, int32 Radius) const;
+    
+    /** Slack for comparing arc ends computed on different rings */
+    static constexpr double ShadowTolerance = 1e-9;
+    
+    bool IsInShadow(double Angle) const;
+    
+    /** Add [Start, End] in turns, splitting it if it wraps past 0 */
+    void AddShadow(double Start, double End);
+    
+    bool IsFullyShadowed() const;
+    
+    bool IsOnMap(FIntPoint GridPos) const
+    {
+        return GridPos.X >= 0 && GridPos.Y >= 0 && GridPos.X < MapSize.X && GridPos.Y < MapSize.Y;
+    }
+    
+    UPROPERTY()
+    UGW_HexWorldState* WorldState = nullptr;
+    
+    FDelegateHandle ExplorationChangedHandle;
+    
+    FGW_HexSightRules Rules;
+    
+    FIntPoint MapSize = FIntPoint::ZeroValue;
+    
+    /** One bit per hex, row-major like the world state */
+    TBitArray<> Occluders;
+    
+    /** Sorted, disjoint shadowed arcs in turns [0, 1) for the cast in progress */
+    TArray<FVector2D> Shadows;
+    
+    TArray<EGW_HexBiome> BiomeScratch;
+};
+#pragma endregion
+/*-------------------------------------------------------------------------*/
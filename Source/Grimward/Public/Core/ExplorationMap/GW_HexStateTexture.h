@@ -0,0 +1,77 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "Core/ExplorationMap/GW_TileTypes.h"
+#include "GW_HexStateTexture.generated.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+class UTexture2D;
+class UGW_HexWorldState;
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Hex State Texture                                                      */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexStateTexture.h
+/**
+ * One texel per hex, coloured by biome and masked by exploration state. The texture is
+ * built once per map; afterwards only the rectangles UGW_HexWorldState reports as changed
+ * are queued with AddPendingRegion and re-coloured in one upload per Flush.
+ * Owners keep it as a UPROPERTY so the texture stays referenced.
+ */
+USTRUCT()
+struct GRIMWARD_API FGW_HexStateTexture
+{
+    GENERATED_BODY()
+    
+    UPROPERTY()
+    UTexture2D* Texture = nullptr;
+    
+    /** Size of Texture in hexes */
+    FIntPoint Size = FIntPoint::ZeroValue;
+    
+    /**
+     * Set the colour per state before the next Rebuild. Each tint is blended over the biome
+     * colour by its alpha, so an opaque HiddenTint hides the biome entirely.
+     */
+    void SetTints(const FLinearColor& HiddenTint, const FLinearColor& ExploredTint, const FLinearColor& ConqueredTint);
+    
+    /** Create the texture if the map size changed and colour every hex; false if there is no map */
+    bool Rebuild(const UGW_HexWorldState* WorldState, TextureFilter Filter);
+    
+    /** Drop the texture and anything queued */
+    void Reset();
+    
+    /** Queue a rectangle for upload, merging it into an overlapping one where possible */
+    void AddPendingRegion(const FIntRect& Region);
+    
+    /** Colour every pending rectangle into one staging buffer and upload it with a single UpdateTextureRegions */
+    void Flush(const UGW_HexWorldState* WorldState);
+
+private:
+    /** Write the texels of Rect (which must lie on the map) into Dest, Pitch texels per row */
+    void FillTexels(const UGW_HexWorldState* WorldState, const FIntRect& Rect, FColor* Dest, int32 Pitch);
+    
+    FLinearColor Tints[3] = { FLinearColor::Black, FLinearColor::Transparent, FLinearColor::Transparent };
+    
+    /** Texel colour per exploration state and biome, rebuilt with the texture */
+    TArray<FColor> ColorTable;
+    
+    /** Changed rectangles not uploaded yet */
+    static constexpr int32 MaxPendingRegions = 8;
+    TArray<FIntRect, TInlineAllocator<MaxPendingRegions>> PendingRegions;
+    
+    // Scratch for colouring a region row by row
+    TArray<EGW_HexTileState> StateScratch;
+    TArray<EGW_HexBiome> BiomeScratch;
+};
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,112 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Styling/SlateBrush.h"
+#include "Core/ExplorationMap/GW_TileTypes.h"
+#include "GW_HexVisualsAsset.generated.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+class UTexture2D;
+struct FStreamableHandle;
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Atlas Region                                                           */
+/*-------------------------------------------------------------------------*/
+USTRUCT(BlueprintType)
+struct FGW_HexAtlasRegion
+{
+    GENERATED_BODY()
+    
+    /** Top-left of the region in normalised atlas UVs */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector2D UVMin = FVector2D::ZeroVector;
+    
+    /** Bottom-right of the region in normalised atlas UVs */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector2D UVMax = FVector2D::UnitVector;
+};
+
+/*-------------------------------------------------------------------------*/
+/*  Hex Visuals Asset                                                      */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexVisualsAsset.h
+/**
+ * Maps biomes and POIs to regions of two texture atlases. The atlases are streamed in
+ * asynchronously once per map, after which every tile of a biome shares one cached brush.
+ */
+UCLASS(BlueprintType)
+class GRIMWARD_API UGW_HexVisualsAsset : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // ========================================
+    // Atlases
+    // ========================================
+    
+    /** Atlas holding one hex image per biome */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Biomes")
+    TSoftObjectPtr<UTexture2D> BiomeAtlas;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Biomes")
+    TMap<EGW_HexBiome, FGW_HexAtlasRegion> BiomeRegions;
+    
+    /** Atlas holding one icon per point of interest */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "POIs")
+    TSoftObjectPtr<UTexture2D> POIAtlas;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "POIs")
+    TMap<EGW_HexPOI, FGW_HexAtlasRegion> POIRegions;
+    
+    // ========================================
+    // Loading
+    // ========================================
+    
+    /** Start streaming both atlases. OnLoaded fires once the brushes are ready (immediately if they already are). */
+    void RequestAsyncLoad(FSimpleDelegate OnLoaded);
+    
+    UFUNCTION(BlueprintPure, Category = "Hex Visuals")
+    bool IsLoaded() const { return bBrushesBuilt; }
+    
+    // ========================================
+    // Brush Cache
+    // ========================================
+    
+    /** Shared brush for a biome, or null while the atlas is still streaming */
+    const FSlateBrush* GetBiomeBrush(EGW_HexBiome Biome) const;
+    
+    /** Shared brush for a POI icon, or null while the atlas is still streaming */
+    const FSlateBrush* GetPOIBrush(EGW_HexPOI POI) const;
+
+private:
+    /** Fill the brush caches from the loaded atlases */
+    void BuildBrushCache();
+    
+    void OnAtlasesLoaded();
+    
+    /** Keeps the atlases resident while the asset is in use */
+    TSharedPtr<FStreamableHandle> LoadHandle;
+    
+    /** Callers waiting on the current load */
+    TArray<FSimpleDelegate> PendingCallbacks;
+    
+    UPROPERTY(Transient)
+    TMap<EGW_HexBiome, FSlateBrush> BiomeBrushes;
+    
+    UPROPERTY(Transient)
+    TMap<EGW_HexPOI, FSlateBrush> POIBrushes;
+    
+    bool bBrushesBuilt = false;
+};
+#pragma endregion
+/*-------------------------------------------------------------------------*/
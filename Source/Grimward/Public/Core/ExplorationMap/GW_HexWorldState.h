@@ -0,0 +1,274 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/ExplorationMap/GW_TileTypes.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "GW_HexWorldState.generated.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+struct FGW_ExplorationSaveData;
+
+/** Fired once per batch of tile changes (exploration, POI or loot) with the grid rectangle (Max exclusive) that changed */
+DECLARE_MULTICAST_DELEGATE_OneParam(FGW_OnExplorationChanged, const FIntRect& /*DirtyRect*/);
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Reveal Mask                                                            */
+/*-------------------------------------------------------------------------*/
+/**
+ * Set of hexes to reveal, laid out in the same 2-bit words as UGW_HexWorldState so
+ * applying it is one bit operation per word rather than one per hex.
+ */
+struct GRIMWARD_API FGW_HexRevealMask
+{
+    /** Grid rectangle the mask covers (Max exclusive), already clipped to the map */
+    FIntRect Bounds;
+    
+    /** Words per mask row (chunk columns spanned by Bounds) */
+    int32 WordsPerRow = 0;
+    
+    /** Low bit of each hex's pair set for hexes in the mask */
+    TArray<uint64> Words;
+    
+    void Init(const FIntRect& InBounds);
+    void Add(FIntPoint GridPos);
+    bool IsEmpty() const { return Words.Num() == 0; }
+};
+
+/*-------------------------------------------------------------------------*/
+/*  Hex Loot                                                               */
+/*-------------------------------------------------------------------------*/
+/** Loot placed on one hex. Collected items are a bitmask over Items, so a pickup never reallocates. */
+struct GRIMWARD_API FGW_HexLoot
+{
+    static constexpr int32 MaxItems = 32;
+    
+    TArray<FName, TInlineAllocator<4>> Items;
+    uint32 CollectedMask = 0;
+    
+    bool IsCollected(int32 ItemIndex) const { return (CollectedMask >> ItemIndex) & 1u; }
+    
+    bool HasRemaining() const
+    {
+        const uint32 AllMask = Items.Num() >= MaxItems ? ~0u : (1u << Items.Num()) - 1u;
+        return (CollectedMask & AllMask) != AllMask;
+    }
+};
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Hex World State                                                        */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexWorldState.h
+/**
+ * World-level tile store, laid out as columns rather than one struct per hex:
+ *  - exploration: 2 bits per hex (Hidden/Explored/Conquered) in dense 32x32 chunks, one uint64 per chunk row
+ *  - biome and POI: one byte each per hex, row-major like the generator
+ *  - loot: a sparse side table keyed by hex index, only for hexes that have any
+ * Tile widgets are views that pull FGW_HexTileData snapshots from here, so state survives culling.
+ * Once a map is bound this is the only source of biomes and POIs: the canvases, pathfinder and
+ * reveal service read it and follow OnExplorationChanged, never the generator.
+ */
+UCLASS()
+class GRIMWARD_API UGW_HexWorldState : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Hexes per chunk side; one uint64 holds a chunk row at 2 bits per hex */
+    static constexpr int32 ChunkSize = 32;
+    static constexpr int32 BitsPerHex = 2;
+    static constexpr uint64 LowBitsMask = 0x5555555555555555ull;
+    
+    // ========================================
+    // Setup
+    // ========================================
+    
+    /** Size the store for a map, mark every hex Hidden and forget which loot was collected */
+    UFUNCTION(BlueprintCallable, Category = "Hex World State")
+    void ResetExploration(int32 InWidth, int32 InHeight);
+    
+    /**
+     * Take the biome and POI columns of a generated map and reset exploration and loot.
+     * Does nothing if the store already holds this map (equal params and generator settings), so
+     * rebuilding the map widget keeps every tile's state. Returns true if it reset.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Hex World State")
+    bool BindMap(AGW_MapGenerator* MapGenerator);
+    
+    /** Hash of the generation params of the bound map (0 if none) */
+    uint32 GetMapKey() const { return MapKey; }
+    
+    /** Generation params of the bound map (defaults if none) */
+    const FGW_MapGenerationParams& GetMapParams() const { return MapParams; }
+    
+    /** Settings hash of the generator that made the bound map (see AGW_MapGenerator::GetSettingsHash) */
+    uint32 GetMapSettingsHash() const { return MapSettingsHash; }
+    
+    /** Seed the bound map was generated with */
+    int32 GetMapSeed() const { return MapSeed; }
+    
+    UFUNCTION(BlueprintPure, Category = "Hex World State")
+    FIntPoint GetMapSize() const { return FIntPoint(Width, Height); }
+    
+    bool IsValidGridPosition(FIntPoint GridPos) const
+    {
+        return GridPos.X >= 0 && GridPos.Y >= 0 && GridPos.X < Width && GridPos.Y < Height;
+    }
+    
+    /** Clamp a rectangle (Max exclusive) to the map */
+    FIntRect ClipRectToMap(const FIntRect& Rect) const;
+    
+    // ========================================
+    // Queries
+    // ========================================
+    
+    /** State of one hex (Hidden outside the map) */
+    UFUNCTION(BlueprintPure, Category = "Hex World State")
+    EGW_HexTileState GetTileState(FIntPoint GridPos) const;
+    
+    /** Decode the states of Rect (clipped to the map) row by row into OutStates; returns the count written */
+    int32 GetTileStatesInRect(const FIntRect& Rect, TArrayView<EGW_HexTileState> OutStates) const;
+    
+    /** Everything known about one hex (defaults outside the map) */
+    UFUNCTION(BlueprintPure, Category = "Hex World State")
+    FGW_HexTileData GetTileData(FIntPoint GridPos) const;
+    
+    /** Snapshot every hex in Coords into OutData (same order) */
+    void GetTileDataForCoords(TArrayView<const FIntPoint> Coords, TArrayView<FGW_HexTileData> OutData) const;
+    
+    EGW_HexBiome GetBiome(FIntPoint GridPos) const
+    {
+        return IsValidGridPosition(GridPos) ? Biomes[GetTileIndex(GridPos)] : EGW_HexBiome::Hill;
+    }
+    
+    EGW_HexPOI GetPOI(FIntPoint GridPos) const
+    {
+        return IsValidGridPosition(GridPos) ? POIs[GetTileIndex(GridPos)] : EGW_HexPOI::None;
+    }
+    
+    /** Copy the biomes of Rect (clipped to the map) row by row into OutBiomes; returns the count written */
+    int32 GetBiomesInRect(const FIntRect& Rect, TArrayView<EGW_HexBiome> OutBiomes) const;
+    
+    /** Biomes at Coords into OutBiomes (same order); off-map coordinates receive Hill */
+    void GetBiomesForCoords(TArrayView<const FIntPoint> Coords, TArrayView<EGW_HexBiome> OutBiomes) const;
+    
+    /** Bumped on every change, for consumers that cache derived data */
+    uint32 GetRevision() const { return Revision; }
+    
+    FGW_OnExplorationChanged& OnExplorationChanged() { return ExplorationChangedEvent; }
+    
+    // ========================================
+    // Mutation
+    // ========================================
+    
+    UFUNCTION(BlueprintCallable, Category = "Hex World State")
+    void SetTileState(FIntPoint GridPos, EGW_HexTileState NewState);
+    
+    /** Set many hexes to the same state with a single change notification */
+    void SetTileStates(TArrayView<const FIntPoint> Coords, EGW_HexTileState NewState);
+    
+    /** Raise every Hidden hex in the mask to Explored (Conquered hexes keep their state); masks not clipped to the map are ignored */
+    void Reveal(const FGW_HexRevealMask& Mask);
+    
+    /** Reveal every hex within Radius steps of Center */
+    UFUNCTION(BlueprintCallable, Category = "Hex World State")
+    void RevealHexRange(FIntPoint Center, int32 Radius);
+    
+    /** Replace the POI on a hex, e.g. once it has been cleared */
+    UFUNCTION(BlueprintCallable, Category = "Hex World State")
+    void SetPOI(FIntPoint GridPos, EGW_HexPOI NewPOI);
+    
+    // ========================================
+    // Loot
+    // ========================================
+    
+    /** Place loot on a hex (up to FGW_HexLoot::MaxItems), replacing what was there; empty clears it */
+    UFUNCTION(BlueprintCallable, Category = "Hex World State")
+    void SetTileLoot(FIntPoint GridPos, const TArray<FName>& Items);
+    
+    /** Mark one uncollected Item on the hex as collected; false if there was none */
+    UFUNCTION(BlueprintCallable, Category = "Hex World State")
+    bool CollectLoot(FIntPoint GridPos, FName Item);
+    
+    /** Items still lying on the hex; returns the count */
+    UFUNCTION(BlueprintCallable, Category = "Hex World State")
+    int32 GetAvailableLoot(FIntPoint GridPos, TArray<FName>& OutItems) const;
+    
+    /** Items already taken from the hex; returns the count */
+    UFUNCTION(BlueprintCallable, Category = "Hex World State")
+    int32 GetCollectedLoot(FIntPoint GridPos, TArray<FName>& OutItems) const;
+    
+    const FGW_HexLoot* FindLoot(FIntPoint GridPos) const
+    {
+        return IsValidGridPosition(GridPos) ? Loot.Find(GetTileIndex(GridPos)) : nullptr;
+    }
+    
+    /** Every hex with loot, keyed by Y * Width + X */
+    const TMap<int32, FGW_HexLoot>& GetLootTable() const { return Loot; }
+    
+    // ========================================
+    // Save
+    // ========================================
+    
+    /** Write the map's params and settings hash, run-length encoded tile states and collected loot */
+    void ExportExploration(FGW_ExplorationSaveData& OutData) const;
+    
+    /**
+     * Replace tile states and collected loot with saved ones. The same map must already be
+     * bound (regenerated from the saved params, equal settings hash); false, with nothing changed, otherwise.
+     * Loot placed after this picks up its saved collected mask.
+     */
+    bool ImportExploration(const FGW_ExplorationSaveData& Data);
+
+private:
+    int32 GetWordIndex(int32 X, int32 Y) const
+    {
+        return ((Y / ChunkSize) * ChunksX + X / ChunkSize) * ChunkSize + Y % ChunkSize;
+    }
+    
+    static int32 GetBitShift(int32 X) { return (X % ChunkSize) * BitsPerHex; }
+    
+    int32 GetTileIndex(FIntPoint GridPos) const { return GridPos.Y * Width + GridPos.X; }
+    
+    void NotifyChanged(const FIntRect& DirtyRect);
+    
+    /** Chunk-major words: chunk (CX, CY) owns ChunkSize consecutive words, one per row */
+    TArray<uint64> Bits;
+    
+    /** Row-major columns, one entry per hex */
+    TArray<EGW_HexBiome> Biomes;
+    TArray<EGW_HexPOI> POIs;
+    
+    /** Sparse: only hexes that were given loot */
+    TMap<int32, FGW_HexLoot> Loot;
+    
+    /** Imported collected masks of hexes whose loot has not been placed yet */
+    TMap<int32, uint32> SavedCollectedMasks;
+    
+    FGW_MapGenerationParams MapParams;
+    uint32 MapSettingsHash = 0;
+    uint32 MapKey = 0;
+    int32 MapSeed = 0;
+    
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 ChunksX = 0;
+    int32 ChunksY = 0;
+    uint32 Revision = 0;
+    
+    FGW_OnExplorationChanged ExplorationChangedEvent;
+};
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -3,7 +3,9 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "GW_TileTypes.h"
+#include "GW_HexMath.h"
 #include "GameFramework/Actor.h"
+#include "Engine/TextureDefines.h"
 #include "GW_MapGenerator.generated.h"
 /*-------------------------------------------------------------------------*/
 
@@ -45,6 +47,115 @@ struct FGW_BiomeData
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	EGW_HexBiome BiomeEntry;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGW_HexPOI POIEntry = EGW_HexPOI::None;		// Rolled by the POI placement stage.
+};
+
+/** Inputs that fully determine a generated map. Used to key generation history and saves. */
+USTRUCT(BlueprintType)
+struct FGW_MapGenerationParams
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Seed = 0;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Width = 128;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Height = 128;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float TemperaturePeriod = 5.f;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 TemperatureOctaves = 1;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MoisturePeriod = 5.f;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MoistureOctaves = 1;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float AltitudePeriod = 5.f;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 AltitudeOctaves = 1;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float VolatilityPeriod = 5.f;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 VolatilityOctaves = 1;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float EnchantmentPeriod = 5.f;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 EnchantmentOctaves = 1;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bGeneratePOIs = true;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bGenerateRivers = false;
+	
+	/** Exact comparison; hashes only narrow the search, equal params mean the same map. */
+	bool operator==(const FGW_MapGenerationParams& Other) const
+	{
+		return Seed == Other.Seed
+			&& Width == Other.Width
+			&& Height == Other.Height
+			&& TemperaturePeriod == Other.TemperaturePeriod
+			&& TemperatureOctaves == Other.TemperatureOctaves
+			&& MoisturePeriod == Other.MoisturePeriod
+			&& MoistureOctaves == Other.MoistureOctaves
+			&& AltitudePeriod == Other.AltitudePeriod
+			&& AltitudeOctaves == Other.AltitudeOctaves
+			&& VolatilityPeriod == Other.VolatilityPeriod
+			&& VolatilityOctaves == Other.VolatilityOctaves
+			&& EnchantmentPeriod == Other.EnchantmentPeriod
+			&& EnchantmentOctaves == Other.EnchantmentOctaves
+			&& bGeneratePOIs == Other.bGeneratePOIs
+			&& bGenerateRivers == Other.bGenerateRivers;
+	}
+	
+	bool operator!=(const FGW_MapGenerationParams& Other) const { return !(*this == Other); }
+	
+	friend uint32 GetTypeHash(const FGW_MapGenerationParams& Params)
+	{
+		uint32 Hash = GetTypeHash(Params.Seed);
+		Hash = HashCombine(Hash, GetTypeHash(Params.Width));
+		Hash = HashCombine(Hash, GetTypeHash(Params.Height));
+		Hash = HashCombine(Hash, GetTypeHash(Params.TemperaturePeriod));
+		Hash = HashCombine(Hash, GetTypeHash(Params.TemperatureOctaves));
+		Hash = HashCombine(Hash, GetTypeHash(Params.MoisturePeriod));
+		Hash = HashCombine(Hash, GetTypeHash(Params.MoistureOctaves));
+		Hash = HashCombine(Hash, GetTypeHash(Params.AltitudePeriod));
+		Hash = HashCombine(Hash, GetTypeHash(Params.AltitudeOctaves));
+		Hash = HashCombine(Hash, GetTypeHash(Params.VolatilityPeriod));
+		Hash = HashCombine(Hash, GetTypeHash(Params.VolatilityOctaves));
+		Hash = HashCombine(Hash, GetTypeHash(Params.EnchantmentPeriod));
+		Hash = HashCombine(Hash, GetTypeHash(Params.EnchantmentOctaves));
+		Hash = HashCombine(Hash, GetTypeHash(Params.bGeneratePOIs));
+		Hash = HashCombine(Hash, GetTypeHash(Params.bGenerateRivers));
+		return Hash;
+	}
+};
+
+/** Walker/Vose alias table for O(1) weighted POI rolls. Built once per biome from the category POI weights. */
+struct FGW_POIAliasTable
+{
+	TArray<EGW_HexPOI> Entries;
+	TArray<float> Probabilities;
+	TArray<int32> Aliases;
+	
+	void Build(const TMap<EGW_HexPOI, float>& Weights);
+	EGW_HexPOI Sample(FRandomStream& Stream) const;
+	bool IsEmpty() const { return Entries.Num() == 0; }
 };
 
 
@@ -95,42 +206,167 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation")
 	int32 EnchantmentOctaves = 1;
 	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation|POI")
+	bool bGeneratePOIs = true;
+	
+	/** Spacing between POIs in the most volatile regions (Volatility = 2). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation|POI", meta = (ClampMin = "1.0"))
+	float POIMinSpacing = 3.f;
+	
+	/** Spacing between POIs in the calmest regions (Volatility = 0). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation|POI", meta = (ClampMin = "1.0"))
+	float POIMaxSpacing = 10.f;
+	
+	/** Approximate edge length (in tiles) of the parallel sampling tiles. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation|POI", meta = (ClampMin = "8"))
+	int32 POITileSize = 64;
+	
+	/** Runs depression filling and flow accumulation over the altitude map and carves rivers. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation|Hydrology")
+	bool bGenerateRivers = false;
+	
+	/** Moisture-weighted upstream area a tile needs before it becomes a river. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation|Hydrology", meta = (ClampMin = "1.0"))
+	float RiverAccumulationThreshold = 250.f;
+	
 	UFUNCTION(BlueprintCallable, Category = "Generation")
 	void GenerateBiomeMap(int32 InSeed);
 	
 	UFUNCTION(BlueprintCallable, Category = "Generation")
 	FGW_BiomeData GetBiomeDataAt(int32 X, int32 Y) const;
 	
+	/** Direct read of a generated tile in odd-q offset coordinates; null when out of bounds. */
+	const FGW_BiomeData* FindBiomeDataAt(FIntPoint GridPos) const
+	{
+		return IsValidGridPosition(GridPos) ? &BiomeMap[GetTileIndex(GridPos.X, GridPos.Y)] : nullptr;
+	}
+	
+	bool IsValidGridPosition(FIntPoint GridPos) const
+	{
+		return GridPos.X >= 0 && GridPos.Y >= 0 && GridPos.X < GenWidth && GridPos.Y < GenHeight && BiomeMap.Num() > 0;
+	}
+	
+	// ========================================
+	// Batch Queries
+	// ========================================
+	
+	/** Clamps a rectangle (Max exclusive) to the generated map. */
+	FIntRect ClipRectToMap(const FIntRect& Rect) const;
+	
+	/** Copies the tiles of Rect, clipped to the map, row by row into OutData. Returns the number written. */
+	int32 GetBiomeDataInRect(const FIntRect& Rect, TArrayView<FGW_BiomeData> OutData) const;
+	
+	/** Biome-only variant of GetBiomeDataInRect that reads the packed biome array. */
+	int32 GetBiomesInRect(const FIntRect& Rect, TArrayView<EGW_HexBiome> OutBiomes) const;
+	
+	/**
+	 * Copies every on-map tile within Radius steps of Center, column by column in axial
+	 * order. OutCoords, if not empty, receives the matching coordinates.
+	 * Both views need room for GetHexRangeCount(Radius) entries. Returns the number written.
+	 */
+	int32 GetBiomeDataInHexRange(FIntPoint Center, int32 Radius, TArrayView<FGW_BiomeData> OutData, TArrayView<FIntPoint> OutCoords = TArrayView<FIntPoint>()) const;
+	
+	/** Copies the tiles at Coords into OutData; off-map coordinates receive default data. */
+	void GetBiomeDataForCoords(TArrayView<const FIntPoint> Coords, TArrayView<FGW_BiomeData> OutData) const;
+	
+	/** Biome-only variant of GetBiomeDataForCoords; off-map coordinates receive Hill. */
+	void GetBiomesForCoords(TArrayView<const FIntPoint> Coords, TArrayView<EGW_HexBiome> OutBiomes) const;
+	
+	/** Debug/preview colour of a biome, shared by the biome texture and the batched hex canvas. */
+	static FColor GetColorForBiome(EGW_HexBiome Biome);
+	
+	/** Number of tiles within Radius steps of a hex, including the hex itself. */
+	static int32 GetHexRangeCount(int32 Radius) { return GW_HexMath::RangeCount(Radius); }
+	
+	/** Generated data is stored row-major over odd-q offset coordinates. */
+	int32 GetTileIndex(int32 X, int32 Y) const { return Y * GenWidth + X; }
+	
+	/**
+	 * Hex-centre sample position of an odd-q offset tile, in units of one column step.
+	 * Matches the flat-topped layout used by UGW_ExplorableHexMap::GridToPixel.
+	 */
+	static FVector2f GetHexSamplePosition(int32 X, int32 Y)
+	{
+		return FVector2f(X, Y * HexRowSpacing + HexColumnParityOffset[X & 1]);
+	}
+	
+	/** Row spacing of a regular flat-topped hex grid relative to its column spacing (sqrt(3) / 1.5). */
+	static constexpr float HexRowSpacing = 1.15470054f;
+	
+	/** Vertical shift of even and odd columns, precomputed per column parity. */
+	static constexpr float HexColumnParityOffset[2] = { 0.0f, 0.5f * HexRowSpacing };
+	
+	/**
+	 * Transient texture with one texel per hex in biome colours, in the biome map's texel order.
+	 * Null if no map has been generated yet.
+	 */
+	UTexture2D* BuildBiomeTexture(TextureFilter Filter = TF_Default) const;
+	
+	/** BuildBiomeTexture for debugging from Blueprint; logs the result */
 	UFUNCTION(BlueprintCallable, Category = "Generation")
 	UTexture2D* GenerateTestDebugTexture();
 	
+	/** Current generation inputs; Seed is the one last generated with. */
 	UFUNCTION(BlueprintCallable, Category = "Generation")
-	const TMap<FIntPoint, FGW_BiomeData>& GetBiomeMap() const { return BiomeMap; }
+	FGW_MapGenerationParams GetGenerationParams() const;
+	
+	/** Copies generation inputs onto the generator without generating. */
+	UFUNCTION(BlueprintCallable, Category = "Generation")
+	void ApplyGenerationParams(const FGW_MapGenerationParams& Params);
+	
+	/** Bump whenever a change to the generation code alters the map produced for the same inputs. */
+	static constexpr uint32 GeneratorVersion = 1;
+	
+	/**
+	 * Hash of GeneratorVersion and every generation setting outside FGW_MapGenerationParams
+	 * (POI spacing and tiling, river threshold, BiomeDataConfig). Equal params and an equal
+	 * settings hash regenerate the same map.
+	 */
+	uint32 GetSettingsHash() const;
+	
+	/** Writes the generated grid (biomes and POIs) to a flat byte buffer. */
+	void ExportGridSnapshot(TArray<uint8>& OutBytes) const;
+	
+	/** Replaces the generated grid with one written by ExportGridSnapshot. */
+	bool ImportGridSnapshot(TArrayView<const uint8> Bytes);
+	
+	UFUNCTION(BlueprintCallable, Category = "Generation")
+	const TArray<FGW_BiomeData>& GetBiomeMap() const { return BiomeMap; }
+	
+	UFUNCTION(BlueprintCallable, Category = "Generation")
+	const TArray<FIntPoint>& GetPOILocations() const { return POILocations; }
 
 protected:
 	virtual void BeginPlay() override;
 	
 private:
-	// Stores the generated data here:
-	TMap<FIntPoint, float> TemperatureMap;
-	TMap<FIntPoint, float> MoistureMap;
-	TMap<FIntPoint, float> AltitudeMap;
-	TMap<FIntPoint, float> VolatilityMap;
-	TMap<FIntPoint, float> EnchantmentMap;
-	TMap<FIntPoint, FGW_BiomeData> BiomeMap;
+	// Stores the generated data here, indexed by GetTileIndex:
+	TArray<float> TemperatureMap;
+	TArray<float> MoistureMap;
+	TArray<float> AltitudeMap;
+	TArray<float> VolatilityMap;
+	TArray<float> EnchantmentMap;
+	TArray<FGW_BiomeData> BiomeMap;
+	TArray<EGW_HexBiome> BiomeTypeMap;				// Packed copy of BiomeEntry for biome-only queries.
+	TArray<FIntPoint> POILocations;
 	
 	// Biome configuration settings - maps categories to probabilities. TODO: Implement presets?
 	TMap<FString, FGW_BiomeGenerationInfo> BiomeDataConfig;
 	
+	// POI roll tables per biome, derived from BiomeDataConfig.
+	TMap<EGW_HexBiome, FGW_POIAliasTable> POIAliasTables;
+	
 	// Helper functions:
-	TMap<FIntPoint, float> GenerateNoiseMap(float Period, int32 Octaves, int32 NoiseSeed);
-	float GetPerlinNoise2D(float X, float Y, float Period, int32 Octaves, int32 NoiseSeed);
+	TArray<float> GenerateNoiseMap(float Period, int32 Octaves, int32 NoiseSeed);
+	float GetPerlinNoise2D(float X, float Y, float Period, int32 Octaves, int32 NoiseSeed) const;
 	void DetermmineBiomes();
 	EGW_HexBiome DetermineBiomeCategory(float Altitude, float Temperature, float Moisture, float Enchantment, FString& OutCategory);
 	EGW_HexBiome GetRandomTileForCategory(const FString& Category);
 	bool IsBetween(float Value, float Start, float End) const;	
 	void InitializeBiomeData();
-	FColor GetColorForBiome(EGW_HexBiome Biome) const;
+	void BuildPOIAliasTables();
+	void PlacePOIs();
+	void GenerateHydrology();
 	
 	
 	FRandomStream RandomStream;
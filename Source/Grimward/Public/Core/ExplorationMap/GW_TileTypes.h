@@ -1,6 +1,7 @@
 // Copyright xTear Studios
 /*-------------------------------------------------------------------------*/
 #pragma once
+#include "CoreMinimal.h"
 #include "GW_TileTypes.generated.h"
 /*-------------------------------------------------------------------------*/
 
@@ -31,7 +32,8 @@ enum class EGW_HexBiome : uint8
 	Lavascape,
 	IceSpike,
 	GreatPeak,
-	Water
+	Water,
+	River
 };
 
 UENUM(BlueprintType)
@@ -55,6 +57,15 @@ enum class EGW_HexPOI : uint8
 	CrystalField,
 };
 
+/** Exploration state of a hex; values fit in 2 bits (see UGW_HexWorldState) */
+UENUM(BlueprintType)
+enum class EGW_HexTileState : uint8
+{
+	Hidden      UMETA(DisplayName = "Hidden"),      // Player hasn't explored
+	Explored    UMETA(DisplayName = "Explored"),    // Player can see it
+	Conquered   UMETA(DisplayName = "Conquered")    // Player defeated it
+};
+
 UENUM(BlueprintType)
 enum class EGW_Megagon : uint8
 {
@@ -72,4 +83,48 @@ enum class EGW_Megagon : uint8
 	TheGreatForge,
 	DimensionalStronghold
 };
+
+/** Snapshot of one hex as held by UGW_HexWorldState; plain data, no allocations */
+USTRUCT(BlueprintType)
+struct FGW_HexTileData
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FIntPoint GridPosition = FIntPoint::ZeroValue;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGW_HexBiome BiomeType = EGW_HexBiome::Hill;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGW_HexPOI POIType = EGW_HexPOI::None;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGW_HexTileState TileState = EGW_HexTileState::Hidden;
+	
+	/** Loot on this hex that has not been collected yet (the items live in the world state) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bHasLoot = false;
+};
+
+/** Items placed on a hex (see UGW_HexWorldState::SetTileLoot) */
+USTRUCT(BlueprintType)
+struct FGW_HexLootList
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FName> Items;
+};
+
+/** A hex easing from one exploration state to another; Alpha runs from 0 to 1 */
+struct FGW_HexTileTransition
+{
+	FIntPoint GridPosition = FIntPoint::ZeroValue;
+	EGW_HexTileState From = EGW_HexTileState::Hidden;
+	EGW_HexTileState To = EGW_HexTileState::Hidden;
+	/** Seconds advanced so far, accumulated from the map's tick delta */
+	float Elapsed = 0.0f;
+	float Alpha = 0.0f;
+};
 /*-------------------------------------------------------------------------*/
\ No newline at end of file
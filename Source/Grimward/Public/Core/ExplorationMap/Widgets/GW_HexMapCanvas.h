@@ -0,0 +1,88 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "Styling/SlateBrush.h"
+#include "Core/ExplorationMap/GW_TileTypes.h"
+#include "GW_HexMapCanvas.generated.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+class SGW_HexMapCanvas;
+class UGW_HexWorldState;
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Hex Map Canvas                                                         */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexMapCanvas.h
+/**
+ * UMG wrapper around SGW_HexMapCanvas. Place it under the hex map's MapCanvas so the
+ * interactive UGW_HexTile widgets draw on top of the batched hexes.
+ */
+UCLASS()
+class GRIMWARD_API UGW_HexMapCanvas : public UWidget
+{
+    GENERATED_BODY()
+
+public:
+    /** Brush mapped onto every hex, tinted with the biome colour */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance")
+    FSlateBrush HexBrush;
+    
+    /** Paint exploration state instead of biomes */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fog")
+    bool bDrawFog = false;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fog")
+    FLinearColor HiddenFogColor = FLinearColor::Black;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fog")
+    FLinearColor ExploredFogColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.3f);
+    
+    /** Map to paint: the biome layers and the fog layer all read the world state */
+    void SetWorldState(const UGW_HexWorldState* InWorldState);
+    
+    void SetView(const FVector2D& InViewOffset, float InZoom, const FVector2D& InHexSize);
+    void SetVisibleRect(const FIntRect& InVisibleRect);
+    
+    /** Restrict painting to these hexes, e.g. placeholders for tiles whose widgets are not created yet */
+    void SetHexList(TArrayView<const FIntPoint> InHexList);
+    void ClearHexList();
+    
+    /** Hexes the fog layer blends between two states, replaced every call (empty to stop) */
+    void SetStateTransitions(TArrayView<const FGW_HexTileTransition> InTransitions);
+    
+    /** Repaint after the map or exploration data changed */
+    void RequestRepaint();
+    
+    virtual void SynchronizeProperties() override;
+    virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+protected:
+    virtual TSharedRef<SWidget> RebuildWidget() override;
+    
+    TSharedPtr<SGW_HexMapCanvas> MyHexCanvas;
+    
+    // Mirrored here so a rebuilt Slate widget starts from the current state
+    TWeakObjectPtr<const UGW_HexWorldState> WorldState;
+    FVector2D ViewOffset = FVector2D::ZeroVector;
+    float Zoom = 1.0f;
+    FVector2D HexSize = FVector2D(150.0f, 130.0f);
+    FIntRect VisibleRect;
+    TArray<FIntPoint> HexList;
+    bool bUseHexList = false;
+    TArray<FGW_HexTileTransition> Transitions;
+    
+    /** Push the fog settings to the Slate widget */
+    void SyncFog();
+};
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -0,0 +1,126 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Core/ExplorationMap/GW_HexStateTexture.h"
+#include "GW_HexMinimapWidget.generated.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+class UImage;
+class UGW_ExplorableHexMap;
+class UGW_HexWorldState;
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Hex Minimap Widget                                                     */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_HexMinimapWidget.h
+/**
+ * Overview of the whole exploration map: one texel per hex, coloured by biome and masked
+ * by exploration state, with the hex map's view drawn on top as a rectangle.
+ * The texture (FGW_HexStateTexture) is built once per map; afterwards only the rectangles
+ * UGW_HexWorldState reports as changed are re-coloured and uploaded, so the cost follows
+ * what changed rather than the map size. Clicking or dragging centres the hex map on that hex.
+ */
+UCLASS()
+class GRIMWARD_API UGW_HexMinimapWidget : public UUserWidget
+{
+    GENERATED_BODY()
+
+protected:
+    // ========================================
+    // Widget Components (Bind in UMG)
+    // ========================================
+    
+    /** Shows the minimap texture; the viewport rectangle and clicks are mapped over its geometry */
+    UPROPERTY(meta = (BindWidget))
+    UImage* MinimapImage;
+    
+    // ========================================
+    // Appearance
+    // ========================================
+    
+    /** Colour of hexes that have not been explored */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap")
+    FLinearColor HiddenColor = FLinearColor(0.02f, 0.02f, 0.03f, 1.0f);
+    
+    /** Blended over the biome colour of conquered hexes */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap")
+    FLinearColor ConqueredTint = FLinearColor(1.0f, 0.8f, 0.2f, 1.0f);
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap", meta = (ClampMin = "0", ClampMax = "1"))
+    float ConqueredTintStrength = 0.35f;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap")
+    FLinearColor ViewportRectColor = FLinearColor::White;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap", meta = (ClampMin = "0.5"))
+    float ViewportRectThickness = 1.5f;
+    
+    // ========================================
+    // State
+    // ========================================
+    
+    /** Hex map this minimap overviews and steers */
+    UPROPERTY(BlueprintReadOnly, Category = "Minimap")
+    UGW_ExplorableHexMap* HexMap;
+    
+    /** One texel per hex, row-major like the generator */
+    UPROPERTY()
+    FGW_HexStateTexture StateTexture;
+    
+    /** Store the texture mirrors */
+    UPROPERTY()
+    UGW_HexWorldState* WorldState;
+    
+    FDelegateHandle ExplorationChangedHandle;
+    
+    /** Dragging across the minimap keeps re-centring the hex map */
+    bool bIsDragging;
+
+public:
+    virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
+    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    
+    /** Overview this hex map; the texture follows its world state from now on */
+    UFUNCTION(BlueprintCallable, Category = "Minimap")
+    void SetHexMap(UGW_ExplorableHexMap* InHexMap);
+    
+    /** Re-colour every hex, e.g. after changing the appearance settings */
+    UFUNCTION(BlueprintCallable, Category = "Minimap")
+    void RebuildTexture();
+    
+    // ========================================
+    // Input Handling
+    // ========================================
+    
+    virtual FReply NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+    virtual FReply NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+    virtual FReply NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+
+protected:
+    virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+    
+    void OnExplorationChanged(const FIntRect& DirtyRect);
+    
+    /** Stop listening to the current world state */
+    void UnbindWorldState();
+    
+    /** Hex under a screen-space point, clamped to the map */
+    FIntPoint ScreenToGrid(FVector2D ScreenSpacePos) const;
+    
+    /** Centre the hex map on the hex under a screen-space point */
+    void CenterHexMapAt(FVector2D ScreenSpacePos);
+};
+#pragma endregion
+/*-------------------------------------------------------------------------*/
@@ -15,61 +15,20 @@
 class UImage;
 class UOverlay;
 class UButton;
+class UGW_HexVisualsAsset;
 /*-------------------------------------------------------------------------*/
 
 
 
-/*-------------------------------------------------------------------------*/
-/*  Hex Tile State                                                         */
-/*-------------------------------------------------------------------------*/
-UENUM(BlueprintType)
-enum class EGW_HexTileState : uint8
-{
-    Hidden      UMETA(DisplayName = "Hidden"),      // Player hasn't explored
-    Explored    UMETA(DisplayName = "Explored"),    // Player can see it
-    Conquered   UMETA(DisplayName = "Conquered")    // Player defeated it
-};
-
-/*-------------------------------------------------------------------------*/
-/*  Hex Tile Data                                                          */
-/*-------------------------------------------------------------------------*/
-USTRUCT(BlueprintType)
-struct FGW_HexTileData
-{
-    GENERATED_BODY()
-    
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    FIntPoint GridPosition;
-    
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    EGW_HexBiome BiomeType;
-    
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    EGW_HexPOI POIType;
-    
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    EGW_HexTileState TileState;
-    
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    TArray<FName> AvailableLoot;
-    
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    TArray<FName> CollectedLoot;
-    
-    FGW_HexTileData()
-        : GridPosition(FIntPoint::ZeroValue)
-        , BiomeType(EGW_HexBiome::Hill)
-        , POIType(EGW_HexPOI::None)
-        , TileState(EGW_HexTileState::Hidden)
-    {
-    }
-};
-
 /*-------------------------------------------------------------------------*/
 /*  Hex Tile Widget                                                        */
 /*-------------------------------------------------------------------------*/
 #pragma region GW_HexTile.h
-UCLASS()
+/**
+ * Tiles only change through explicit calls (data, selection, state transitions), so they
+ * never tick and stay cached inside the map's TileLayerCache between those calls.
+ */
+UCLASS(meta = (DisableNativeTick))
 class GRIMWARD_API UGW_HexTile : public UUserWidget
 {
     GENERATED_BODY()
@@ -103,14 +62,15 @@ protected:
     UPROPERTY(meta = (BindWidgetOptional))
     UImage* SelectionBorder;
     
-    /** Clickable button overlay */
-    UPROPERTY(meta = (BindWidget))
+    /** Legacy button overlay; tiles are hit-test invisible and input comes from the map */
+    UPROPERTY(meta = (BindWidgetOptional))
     UButton* TileButton;
     
     // ========================================
     // Tile Data
     // ========================================
     
+    /** Last snapshot pulled from UGW_HexWorldState; the store owns the real state */
     UPROPERTY(BlueprintReadOnly, Category = "Hex Tile")
     FGW_HexTileData TileData;
     
@@ -120,25 +80,52 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "Hex Tile")
     bool bIsSelected;
     
+    /** Shared atlas brushes, owned by the map */
+    UPROPERTY()
+    UGW_HexVisualsAsset* Visuals;
+    
+    /** False when the map draws fog as one layer, so FogOverlay stays collapsed */
+    bool bUseFogOverlay = true;
+    
+    /** Designer brushes of BiomeImage and TilePOI, shown while the atlas has no brush for the tile */
+    FSlateBrush DefaultBiomeBrush;
+    FSlateBrush DefaultPOIBrush;
+    
 public:
     // ========================================
     // Initialization
     // ========================================
     
+    virtual void NativeOnInitialized() override;
     virtual void NativeConstruct() override;
     
-    /** Initialize tile with data from map generator */
+    /** Initialize tile with a snapshot from the world state */
     UFUNCTION(BlueprintCallable, Category = "Hex Tile")
     void InitializeTile(const FGW_HexTileData& InTileData, FVector2D InPixelPosition);
     
+    /** Re-sync with a newer snapshot of the same hex, touching only what changed */
+    void ApplyTileData(const FGW_HexTileData& InTileData);
+    
+    /** Set the visuals asset the biome and POI brushes come from */
+    void SetVisuals(UGW_HexVisualsAsset* InVisuals) { Visuals = InVisuals; }
+    
+    /** Re-apply biome and POI brushes, e.g. once the atlases finish streaming */
+    void RefreshVisuals();
+    
+    /** Let the map take over fog drawing from the per-tile overlay */
+    void SetUseFogOverlay(bool bInUseFogOverlay) { bUseFogOverlay = bInUseFogOverlay; }
+    
     // ========================================
     // State Management
     // ========================================
     
-    /** Update tile visual state */
+    /** Update tile visual state and fire BP_OnStateChanged */
     UFUNCTION(BlueprintCallable, Category = "Hex Tile")
     void SetTileState(EGW_HexTileState NewState);
     
+    /** Blend the overlays From -> To by Alpha (0..1); the map drives this for every animating tile at once */
+    void ApplyStateTransition(EGW_HexTileState From, EGW_HexTileState To, float Alpha);
+    
     /** Update the biome texture */
     UFUNCTION(BlueprintCallable, Category = "Hex Tile")
     void UpdateBiomeVisuals(EGW_HexBiome Biome);
@@ -152,7 +139,7 @@ public:
     void SetSelected(bool bSelected);
     
     // ========================================
-    // Input Handling
+    // Input Handling (routed from UGW_ExplorableHexMap)
     // ========================================
     
     UFUNCTION()
@@ -185,7 +172,10 @@ public:
     UFUNCTION(BlueprintImplementableEvent, Category = "Hex Tile")
     void BP_OnTileClicked();
     
-    /** Called when tile state changes - implement in BP for transitions */
+    /**
+     * Called when SetTileState is used directly. State changes coming from the world state
+     * (reveals, conquests) are animated natively by the map and do not fire this.
+     */
     UFUNCTION(BlueprintImplementableEvent, Category = "Hex Tile")
     void BP_OnStateChanged(EGW_HexTileState NewState);
 };
@@ -0,0 +1,112 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+#include "Rendering/RenderingCommon.h"
+#include "Core/ExplorationMap/GW_TileTypes.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+class UGW_HexWorldState;
+struct FSlateBrush;
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Hex Map Canvas (Slate)                                                 */
+/*-------------------------------------------------------------------------*/
+#pragma region SGW_HexMapCanvas.h
+/**
+ * Leaf widget that paints every visible hex of the exploration map in a single
+ * custom-verts draw element, instead of one widget per hex.
+ */
+class GRIMWARD_API SGW_HexMapCanvas : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SGW_HexMapCanvas)
+        : _HexBrush(nullptr)
+    {}
+        /** Brush whose texture is mapped onto each hex; plain white when null */
+        SLATE_ARGUMENT(const FSlateBrush*, HexBrush)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+    
+    // ========================================
+    // State
+    // ========================================
+    
+    void SetHexBrush(const FSlateBrush* InHexBrush);
+    
+    /** Map to paint; biomes and exploration state are both read from it */
+    void SetWorldState(const UGW_HexWorldState* InWorldState);
+    
+    /** Same offset/zoom convention as UGW_ExplorableHexMap::GetScreenPosition */
+    void SetView(const FVector2D& InViewOffset, float InZoom, const FVector2D& InHexSize);
+    
+    /** Grid rectangle to paint (Max exclusive) */
+    void SetVisibleRect(const FIntRect& InVisibleRect);
+    
+    /** Paint only these hexes (still clipped to the visible rect) instead of the whole rectangle */
+    void SetHexList(TArrayView<const FIntPoint> InHexList);
+    
+    /** Go back to painting the whole visible rectangle */
+    void ClearHexList();
+    
+    /** Turn this canvas into a fog layer: hexes are coloured by exploration state instead of biome */
+    void SetFog(bool bInDrawFog, const FLinearColor& InHiddenColor, const FLinearColor& InExploredColor);
+    
+    /** Fog layers blend these hexes between their From and To colours instead of painting the stored state */
+    void SetStateTransitions(TArrayView<const FGW_HexTileTransition> InTransitions);
+    
+    /** Repaint after the underlying map or exploration data changed */
+    void RequestRepaint();
+    
+    // ========================================
+    // SWidget
+    // ========================================
+    
+    virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+    
+    virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+    
+    /** Corners of a flat-topped hex around its centre, in units of half width / half height */
+    static const FVector2f HexCorners[6];
+
+private:
+    const FSlateBrush* HexBrush = nullptr;
+    TWeakObjectPtr<const UGW_HexWorldState> WorldState;
+    
+    FVector2D ViewOffset = FVector2D::ZeroVector;
+    float Zoom = 1.0f;
+    FVector2D HexSize = FVector2D(150.0f, 130.0f);
+    FIntRect VisibleRect;
+    TArray<FIntPoint> HexList;
+    bool bUseHexList = false;
+    
+    bool bDrawFog = false;
+    FLinearColor HiddenFogColor = FLinearColor::Black;
+    FLinearColor ExploredFogColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.3f);
+    TArray<FGW_HexTileTransition> Transitions;
+    
+    /** Fog colour of a state before the widget tint; conquered hexes are clear */
+    FLinearColor GetFogColor(EGW_HexTileState State) const;
+    
+    // Reused between paints so steady-state painting does not allocate
+    mutable TArray<FSlateVertex> Vertices;
+    mutable TArray<SlateIndex> Indices;
+    mutable TArray<EGW_HexBiome> BiomeScratch;
+    mutable TArray<EGW_HexTileState> StateScratch;
+    
+    /** Hexes of the fog rectangle painted as transitions, row-major over the painted rect */
+    mutable TBitArray<> TransitionMask;
+};
+#pragma endregion
+/*-------------------------------------------------------------------------*/
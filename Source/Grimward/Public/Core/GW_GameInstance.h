@@ -9,6 +9,15 @@
 
 
 
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+class AGW_MapGenerator;
+class UGW_HexWorldState;
+/*-------------------------------------------------------------------------*/
+
+
+
 /*-------------------------------------------------------------------------*/
 /*  Game Instance                                                          */
 /*-------------------------------------------------------------------------*/
@@ -90,11 +99,26 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Grimward|Save")
     void ResetProgress();
 
+    /** Regenerate the saved exploration map on MapGenerator; false if there is none or the generator settings changed */
+    UFUNCTION(BlueprintCallable, Category = "Grimward|Save")
+    bool RegenerateSavedMap(AGW_MapGenerator* MapGenerator);
+
+    /** Apply saved exploration to the current world once the regenerated map is bound (UGW_ExplorableHexMap::InitializeMap) */
+    UFUNCTION(BlueprintCallable, Category = "Grimward|Save")
+    bool RestoreSavedExploration();
+
 private:
     int32 CalculateExperienceForNextLevel() const;
     
+    /** Exploration store of the current world, if it has one */
+    class UGW_HexWorldState* GetHexWorldState() const;
+    
     UPROPERTY()
     class UGW_SaveGame* CurrentSaveGame;
+    
+    /** Store and revision CurrentSaveGame's exploration was exported from; unchanged, SaveGame reuses it */
+    TWeakObjectPtr<const UGW_HexWorldState> SavedExplorationSource;
+    uint32 SavedExplorationRevision = 0;
 
     const FString SaveSlotName = TEXT("GrimwardSave");
 };
@@ -0,0 +1,62 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "Grimward.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Log Rate Limiter                                                       */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_Logging.h
+/**
+ * Lets one log line through per interval and counts the ones it held back, so a message
+ * fired every frame or every tile costs a counter increment most of the time.
+ * Intervals are scaled by gw.Log.RateLimitScale (0 lets every line through).
+ * Not thread-safe; meant for game-thread call sites.
+ */
+struct GRIMWARD_API FGW_LogRateLimiter
+{
+    explicit FGW_LogRateLimiter(float InIntervalSeconds = 1.0f)
+        : IntervalSeconds(InIntervalSeconds)
+    {
+    }
+    
+    /** True if a line may be written now; OutSuppressed receives the lines dropped since the last one */
+    bool TryLog(int32& OutSuppressed);
+
+private:
+    float IntervalSeconds;
+    double NextLogTime = 0.0;
+    int32 Suppressed = 0;
+};
+#pragma endregion
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Macros                                                                 */
+/*-------------------------------------------------------------------------*/
+/**
+ * UE_LOG that writes at most one line per IntervalSeconds from this call site, with the
+ * number of lines skipped in between appended. Compiled out with the category's verbosity
+ * ceiling, and the limiter is not even touched while the verbosity is off at runtime.
+ */
+#define GW_LOG_RATE_LIMITED(CategoryName, Verbosity, IntervalSeconds, Format, ...) \
+    do \
+    { \
+        if (UE_LOG_ACTIVE(CategoryName, Verbosity)) \
+        { \
+            static FGW_LogRateLimiter GW_RateLimiter(IntervalSeconds); \
+            int32 GW_Suppressed = 0; \
+            if (GW_RateLimiter.TryLog(GW_Suppressed)) \
+            { \
+                UE_LOG(CategoryName, Verbosity, Format TEXT(" (%d similar suppressed)"), ##__VA_ARGS__, GW_Suppressed); \
+            } \
+        } \
+    } \
+    while (0)
+/*-------------------------------------------------------------------------*/
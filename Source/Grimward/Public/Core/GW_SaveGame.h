@@ -4,11 +4,67 @@
 #include "CoreMinimal.h"
 #include "GameFramework/SaveGame.h"
 #include "GW_GameData.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
 #include "GW_SaveGame.generated.h"
 /*-------------------------------------------------------------------------*/
 
 
 
+/*-------------------------------------------------------------------------*/
+/*  Exploration Save                                                       */
+/*-------------------------------------------------------------------------*/
+/**
+ * Exploration map progress without the map itself: the world is regenerated from Params on
+ * load (the generator's settings hash must still match) and only what the player changed
+ * is stored. Written and read by UGW_HexWorldState::ExportExploration/ImportExploration.
+ */
+USTRUCT()
+struct FGW_ExplorationSaveData
+{
+	GENERATED_BODY()
+	
+	/** Bumped when the encoding of TileStates or the map identity changes */
+	static constexpr int32 CurrentVersion = 2;
+	
+	UPROPERTY()
+	int32 Version = 0;
+	
+	/** Everything the map was generated from, Seed included */
+	UPROPERTY()
+	FGW_MapGenerationParams Params;
+	
+	/** AGW_MapGenerator::GetSettingsHash of the generator that made the map */
+	UPROPERTY()
+	uint32 GeneratorSettingsHash = 0;
+	
+	UPROPERTY()
+	int32 Width = 0;
+	
+	UPROPERTY()
+	int32 Height = 0;
+	
+	/**
+	 * Tile states row by row. Each row starts with a mode byte:
+	 *  0 = runs, varints of (Length << 2 | State) until the row is full
+	 *  1 = packed, 2 bits per hex, 4 hexes per byte
+	 * whichever is smaller, so a row never costs more than Width / 4 + 1 bytes.
+	 */
+	UPROPERTY()
+	TArray<uint8> TileStates;
+	
+	/** Hexes with collected loot (Y * Width + X) and their collected masks, same order */
+	UPROPERTY()
+	TArray<int32> LootTileIndices;
+	
+	UPROPERTY()
+	TArray<uint32> LootCollectedMasks;
+	
+	bool HasMap() const { return Version > 0 && Width > 0 && Height > 0; }
+};
+/*-------------------------------------------------------------------------*/
+
+
+
 /*-------------------------------------------------------------------------*/
 /*  Functions                                                              */
 /*-------------------------------------------------------------------------*/
@@ -26,6 +82,9 @@ public:
 
 	UPROPERTY(VisibleAnywhere, Category = "Grimward|Save")
 	FDateTime SaveTime;
+
+	UPROPERTY()
+	FGW_ExplorationSaveData Exploration;
 };
 #pragma endregion 
 /*-------------------------------------------------------------------------*/
\ No newline at end of file
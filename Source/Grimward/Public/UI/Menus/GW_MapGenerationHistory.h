@@ -0,0 +1,117 @@
+// Copyright xTear Studios
+/*-------------------------------------------------------------------------*/
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
+#include "GW_MapGenerationHistory.generated.h"
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  Declarations                                                           */
+/*-------------------------------------------------------------------------*/
+class UTexture2D;
+/*-------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------------*/
+/*  History Entry                                                          */
+/*-------------------------------------------------------------------------*/
+USTRUCT()
+struct FGW_MapHistoryEntry
+{
+    GENERATED_BODY()
+    
+    UPROPERTY()
+    FGW_MapGenerationParams Params;
+    
+    /** Preview texture, only kept while the entry is hot */
+    UPROPERTY()
+    UTexture2D* Texture = nullptr;
+    
+    /** Grid snapshot from AGW_MapGenerator::ExportGridSnapshot, compressed once the entry goes cold */
+    TArray<uint8> GridBytes;
+    
+    int32 RawGridSize = 0;
+    uint32 ParamHash = 0;
+    uint64 LastUsed = 0;
+    bool bCompressed = false;
+    
+    int64 GetMemorySize() const;
+};
+
+/*-------------------------------------------------------------------------*/
+/*  Map Generation History                                                 */
+/*-------------------------------------------------------------------------*/
+#pragma region GW_MapGenerationHistory.h
+/**
+ * Bounded LRU cache of generated maps keyed by parameter hash, plus the undo/redo timeline.
+ * The most recently used entries stay uncompressed with their texture; older ones keep only
+ * a compressed grid and rebuild the texture on restore.
+ */
+UCLASS()
+class GRIMWARD_API UGW_MapGenerationHistory : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /** Total memory the cache may use before evicting least recently used entries */
+    int64 MemoryBudgetBytes = 256ll * 1024 * 1024;
+    
+    /** How many recent entries stay uncompressed with their texture */
+    int32 MaxHotEntries = 2;
+    
+    /** Longest undo timeline kept */
+    int32 MaxTimelineLength = 64;
+    
+    // ========================================
+    // Cache
+    // ========================================
+    
+    /** Load the cached result for Params into the generator. Returns false on a cache miss. */
+    bool Restore(const FGW_MapGenerationParams& Params, AGW_MapGenerator* Generator, UTexture2D*& OutTexture);
+    
+    /** Cache the generator's current grid and its texture under Params */
+    void Store(const FGW_MapGenerationParams& Params, const AGW_MapGenerator* Generator, UTexture2D* Texture);
+    
+    /** Memory currently used by cached entries */
+    int64 GetMemoryUsage() const;
+    
+    int32 GetNumEntries() const { return Entries.Num(); }
+    
+    // ========================================
+    // Timeline
+    // ========================================
+    
+    /** Record Params as the newest step, dropping any redo steps */
+    void PushTimeline(const FGW_MapGenerationParams& Params);
+    
+    bool CanUndo() const { return TimelineIndex > 0; }
+    bool CanRedo() const { return TimelineIndex + 1 < Timeline.Num(); }
+    
+    /** Step back/forward in the timeline and return the params to show */
+    bool Undo(FGW_MapGenerationParams& OutParams);
+    bool Redo(FGW_MapGenerationParams& OutParams);
+
+private:
+    UPROPERTY()
+    TArray<FGW_MapHistoryEntry> Entries;
+    
+    TArray<FGW_MapGenerationParams> Timeline;
+    int32 TimelineIndex = INDEX_NONE;
+    uint64 UseCounter = 0;
+    
+    /** Entry cached for exactly these params; the hash only skips the full comparison */
+    FGW_MapHistoryEntry* FindEntry(const FGW_MapGenerationParams& Params);
+    
+    /** Compress everything but the MaxHotEntries most recent entries, then evict down to budget (never Keep's entry) */
+    void EnforceBudget(const FGW_MapGenerationParams& Keep);
+    
+    static void CompressEntry(FGW_MapHistoryEntry& Entry);
+    static bool DecompressEntry(const FGW_MapHistoryEntry& Entry, TArray<uint8>& OutRawBytes);
+};
+#pragma endregion
+/*-------------------------------------------------------------------------*/
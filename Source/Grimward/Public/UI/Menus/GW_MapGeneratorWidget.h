@@ -3,6 +3,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Core/ExplorationMap/GW_MapGenerator.h"
 #include "GW_MapGeneratorWidget.generated.h"
 /*-------------------------------------------------------------------------*/
 
@@ -16,7 +17,7 @@ class USlider;
 class UTextBlock;
 class UImage;
 class UEditableTextBox;
-class AGW_MapGenerator;
+class UGW_MapGenerationHistory;
 /*-------------------------------------------------------------------------*/
 
 
@@ -104,6 +105,12 @@ protected:
     UPROPERTY(meta = (BindWidget))
     UButton* SaveImageButton;
 
+    UPROPERTY(meta = (BindWidgetOptional))
+    UButton* UndoButton;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    UButton* RedoButton;
+
     // Map Display
     UPROPERTY(meta = (BindWidget))
     UImage* GeneratedMapImage;
@@ -111,6 +118,14 @@ protected:
     // Status Label
     UPROPERTY(meta = (BindWidget))
     UTextBlock* StatusLabel;
+
+    // History
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "History", meta = (ClampMin = "0"))
+    int32 HistoryMemoryBudgetMB = 256;
+
+    /** Recent results kept uncompressed, with their texture, for instant restore */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "History", meta = (ClampMin = "1"))
+    int32 HistoryHotEntries = 2;
     
 private:
     UPROPERTY()
@@ -119,6 +134,12 @@ private:
     UPROPERTY()
     UTexture2D* MapTexture;
 
+    UPROPERTY()
+    UGW_MapGenerationHistory* History;
+
+    // Set while inputs are being written from history so their callbacks don't regenerate
+    bool bApplyingHistory = false;
+
     // Callback functions
     UFUNCTION()
     void OnGenerateButtonClicked();
@@ -129,6 +150,12 @@ private:
     UFUNCTION()
     void OnSaveImageButtonClicked();
 
+    UFUNCTION()
+    void OnUndoButtonClicked();
+
+    UFUNCTION()
+    void OnRedoButtonClicked();
+
     UFUNCTION()
     void OnTemperaturePeriodChanged(float Value);
     
@@ -147,6 +174,10 @@ private:
     // Helper functions
     void UpdateAllLabels();
     void GenerateMap();
+    void ShowMapForParams(const FGW_MapGenerationParams& Params, bool bRecordInTimeline);
+    FGW_MapGenerationParams GatherParamsFromInputs();
+    void ApplyParamsToInputs(const FGW_MapGenerationParams& Params);
+    void UpdateHistoryButtons();
     void SaveMapToFile();
     int32 GetSeedFromInput();
     int32 GetOctaveFromInput(UEditableTextBox* Input, int32 DefaultValue);